@@ -0,0 +1,226 @@
+// Headless benchmark of do_inspection over synthetic data.
+// An ImGui context without any backend is driven through NewFrame/Render, so this runs without a GPU or a window.
+// Every workload reports ns/frame, heap allocations/frame, rows/frame and the vertex and index counts of the draw data.
+// ImGui does not count submitted items, rows (the height of the laid out content over the frame height) stand in for widgets.
+// Exits with 1 when a workload that should not touch the heap once its caches are warm allocates.
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iminspect.hpp>
+#include <imgui.h>
+#include <map>
+#include <new>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+namespace {
+std::atomic<std::size_t> allocations = 0;
+} // namespace
+
+void* operator new(const std::size_t size)
+{
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void* operator new[](const std::size_t size) { return ::operator new(size); }
+void  operator delete(void* p) noexcept { std::free(p); }
+void  operator delete[](void* p) noexcept { std::free(p); }
+void  operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void  operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+struct Leaf {
+  int                                     id;
+  float                                   weight;
+  std::string                             label;
+  std::optional<double>                   score;
+  std::variant<int, std::string, float>   payload;
+};
+
+struct Branch {
+  Leaf                                                       left;
+  Leaf                                                       right;
+  std::array<float, 4>                                       color;
+  std::tuple<int, std::tuple<float, std::tuple<double, char>>> nested;
+};
+
+struct Tree {
+  Branch           a;
+  Branch           b;
+  Branch           c;
+  std::vector<int> ids;
+};
+
+struct Particle {
+  float        x;
+  float        y;
+  float        z;
+  int          id;
+  bool         alive;
+  std::uint8_t flags;
+};
+
+struct Columns {
+  std::vector<float>         x;
+  std::vector<float>         y;
+  std::vector<float>         z;
+  std::vector<std::uint32_t> flags;
+};
+
+using T4        = std::tuple<float, float, float, float>;
+using Matrix    = std::tuple<T4, T4, T4, T4>;
+using Intern    = std::tuple<Matrix, Matrix, Matrix, Matrix>;
+using Variant   = std::variant<int, float, std::string, std::vector<int>>;
+using Optionals = std::vector<std::optional<Leaf>>;
+
+Leaf make_leaf(const int i)
+{
+  Leaf l{i, float(i) * 0.5f, "leaf " + std::to_string(i), std::nullopt, i};
+  if (i % 2)
+    l.score = i * 0.25;
+  if (i % 3 == 1)
+    l.payload = std::string("payload");
+  return l;
+}
+
+struct Stats {
+  double ns;
+  double allocs;
+  double rows;
+  double vertices;
+  double indices;
+};
+
+template<typename T>
+Stats run(T& data, const int frames)
+{
+  auto& io = ImGui::GetIO();
+
+  const auto frame = [&] {
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(io.DisplaySize);
+    ImGui::Begin("Benchmark");
+    const float top = ImGui::GetCursorPosY();
+    ImInspect::do_inspection(data, "data");
+    const float rows = (ImGui::GetCursorPosY() - top) / ImGui::GetFrameHeightWithSpacing();
+    ImGui::End();
+    ImGui::Render();
+    return rows;
+  };
+
+  // the first frames open the nodes and fill the caches
+  for (int i = 0; i < 10; ++i)
+    frame();
+
+  Stats      s{};
+  const auto allocs_before = allocations.load();
+  const auto start         = std::chrono::steady_clock::now();
+  for (int i = 0; i < frames; ++i) {
+    s.rows += frame();
+    s.vertices += ImGui::GetDrawData()->TotalVtxCount;
+    s.indices += ImGui::GetDrawData()->TotalIdxCount;
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  s.ns     = double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / frames;
+  s.allocs = double(allocations.load() - allocs_before) / frames;
+  s.rows /= frames;
+  s.vertices /= frames;
+  s.indices /= frames;
+  return s;
+}
+
+bool failed = false;
+
+template<typename T>
+void report(const char* name, T& data, const int frames, const bool allocation_free)
+{
+  const auto s = run(data, frames);
+  std::printf("%-22s %12.0f %12.1f %10.1f %12.0f %12.0f\n", name, s.ns, s.allocs, s.rows, s.vertices, s.indices);
+  if (allocation_free && s.allocs != 0) {
+    std::printf("  ^ expected no allocations in steady state\n");
+    failed = true;
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  const int frames = argc > 1 ? std::atoi(argv[1]) : 200;
+
+  ImGui::CreateContext();
+  auto& io       = ImGui::GetIO();
+  io.DisplaySize = ImVec2(1920, 1080);
+  io.DeltaTime   = 1.0f / 60.0f;
+  io.IniFilename = nullptr;
+
+  unsigned char* pixels;
+  int            width, height;
+  io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+  ImInspect::GetConfig().DefaultOpenNodes = true;
+
+  Tree tree{};
+  tree.ids.resize(32);
+
+  std::vector<float> floats(100'000);
+  for (std::size_t i = 0; i < floats.size(); ++i)
+    floats[i] = float(i);
+
+  std::vector<Leaf> leaves;
+  for (int i = 0; i < 10'000; ++i)
+    leaves.push_back(make_leaf(i));
+
+  std::vector<Particle> particles(100'000);
+  for (int i = 0; i < 100'000; ++i)
+    particles[i] = {float(i), float(i % 7), float(i % 13), i, i % 3 != 0, std::uint8_t(i)};
+
+  Columns columns;
+  for (int i = 0; i < 100'000; ++i) {
+    columns.x.push_back(float(i));
+    columns.y.push_back(float(i % 7));
+    columns.z.push_back(float(i % 13));
+    columns.flags.push_back(std::uint32_t(i));
+  }
+
+  std::map<std::string, float> map;
+  for (int i = 0; i < 10'000; ++i)
+    map.emplace("key " + std::to_string(i), float(i));
+
+  std::vector<Variant> variants;
+  for (int i = 0; i < 1'000; ++i)
+    variants.push_back(i % 2 ? Variant(i) : Variant(std::string("text")));
+
+  Optionals optionals;
+  for (int i = 0; i < 1'000; ++i)
+    optionals.push_back(i % 2 ? std::optional<Leaf>(make_leaf(i)) : std::nullopt);
+
+  Intern intern{};
+
+  std::printf("%-22s %12s %12s %10s %12s %12s\n", "workload", "ns/frame", "allocs/frame", "rows/frame", "vertices",
+              "indices");
+  report("deep aggregate", tree, frames, true);
+  report("vector<float> 100k", floats, frames, true);
+  report("vector<Leaf> 10k", leaves, frames, true);
+  report("vector<Particle> 100k", particles, frames, true);
+  report("SoA columns 100k", columns, frames, true);
+  report("map<string,float> 10k", map, frames, true);
+  report("vector<variant> 1k", variants, frames, true);
+  report("vector<optional> 1k", optionals, frames, true);
+  report("nested tuples", intern, frames, true);
+
+  ImGui::DestroyContext();
+  return failed ? 1 : 0;
+}
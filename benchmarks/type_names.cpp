@@ -0,0 +1,104 @@
+// Stress benchmark for the type name normalizer on pathological ~10k character names.
+// Every case is also run at twice the size, a ns/char ratio close to 1 means the normalizer stays linear.
+// Nested MSVC vectors more than double per step, so they have no comparable name at twice the size.
+#include <chrono>
+#include <cstdio>
+#include <iminspect.hpp>
+#include <string>
+#include <string_view>
+
+namespace {
+
+std::string nested_msvc_vectors(const std::size_t size)
+{
+  std::string s = "int";
+  while (s.size() < size)
+    s = "class std::vector<" + s + ",class std::allocator<" + s + "> >";
+  return s;
+}
+
+std::string deep_nesting(const std::size_t size)
+{
+  const auto depth = size / 4;
+  std::string s;
+  for (std::size_t i = 0; i < depth; ++i)
+    s += "A<";
+  s += "int";
+  s.append(depth, '>');
+  return s;
+}
+
+std::string wide_tuple(const std::size_t size)
+{
+  std::string s = "std::tuple<int";
+  while (s.size() < size)
+    s += ", std::basic_string<char, std::char_traits<char>, std::allocator<char> >";
+  return s + ">";
+}
+
+std::string lambdas(const std::size_t size)
+{
+  std::string s = "std::tuple<";
+  while (s.size() < size)
+    s += "LamdbaInName<<lambda()>{}>, LamdbaInName<(lambda at /home/user/project/examples/main.cpp:17:26)>, ";
+  return s + "int>";
+}
+
+std::string unbalanced(const std::size_t size) { return std::string(size / 2, '<') + std::string(size / 2, '('); }
+
+double ns_per_call(const std::string& name)
+{
+  using clock = std::chrono::steady_clock;
+
+  std::size_t checksum   = 0;
+  std::size_t iterations = 0;
+  const auto  start      = clock::now();
+  auto        now        = start;
+  do {
+    checksum += ImInspect::details::normalize_type_name_structurally(name).size();
+    ++iterations;
+    now = clock::now();
+  } while (now - start < std::chrono::milliseconds(200));
+
+  if (checksum == 0)
+    std::puts("");
+  return std::chrono::duration<double, std::nano>(now - start).count() / static_cast<double>(iterations);
+}
+
+} // namespace
+
+int main()
+{
+  struct Case {
+    const char* name;
+    std::string (*make)(std::size_t);
+    bool scales = true;
+  };
+  static constexpr Case cases[] = {
+    {"nested msvc vectors", nested_msvc_vectors, false},
+    {"deep nesting", deep_nesting},
+    {"wide tuple", wide_tuple},
+    {"lambdas", lambdas},
+    {"unbalanced", unbalanced},
+  };
+
+  std::printf("%-22s %10s %14s %10s %12s\n", "case", "chars", "ns/call", "ns/char", "at 2x size");
+  for (const auto& c : cases) {
+    const auto small   = c.make(10'000);
+    const auto t_small = ns_per_call(small);
+    std::printf("%-22s %10zu %14.0f %10.2f",
+                c.name,
+                small.size(),
+                t_small,
+                t_small / static_cast<double>(small.size()));
+    if (!c.scales) {
+      std::printf(" %12s\n", "-");
+      continue;
+    }
+
+    const auto large   = c.make(20'000);
+    const auto t_large = ns_per_call(large);
+    std::printf(" %12.2f\n",
+                (t_large / static_cast<double>(large.size())) / (t_small / static_cast<double>(small.size())));
+  }
+}
@@ -51,7 +51,8 @@ struct BasicComponentMeta {
 
   // successfully can added
   virtual bool add_component_menu(Registry& registry, entity_type entity) const = 0;
-  virtual void draw(Registry& registry, entity_type entity) const               = 0;
+  // true when the component was edited or removed
+  virtual bool draw(Registry& registry, entity_type entity) const = 0;
 };
 
 template<typename Registry, typename Component>
@@ -85,15 +86,16 @@ struct ComponentMeta : BasicComponentMeta<Registry> {
     return false;
   }
 
-  void draw(Registry& registry, entity_type entity) const override
+  bool draw(Registry& registry, entity_type entity) const override
   {
+    bool changed = false;
     if (auto* comp = registry.template try_get<Component>(entity)) {
       // square size matching the header height
       const float size = ImGui::GetFrameHeight();
 
       if (ImGui::Button("-", ImVec2(size, size))) {
         remove_component(registry, entity);
-        return;
+        return true;
       }
 
       ImGui::SameLine();
@@ -107,11 +109,15 @@ struct ComponentMeta : BasicComponentMeta<Registry> {
       ImInspect::colored_pretty_typename(normalized, 0.0f);
       if (clicked) {
         //ImGui::Indent(size + ImGui::GetStyle().ItemSpacing.x);
-        ImInspect::do_inspection(*comp, normalized);
+        changed = ImInspect::do_inspection(*comp, std::string(normalized));
         //ImGui::Unindent(size + ImGui::GetStyle().ItemSpacing.x);
       }
       ImGui::EndGroup();
     }
+    // lets on_update observers of the registry react to the edit
+    if (changed)
+      registry.template patch<Component>(entity);
+    return changed;
   }
 };
 
@@ -126,7 +132,7 @@ public:
   Editor(std::string name = "Entt Editor") : mName(static_cast<std::string&&>(name)) {}
 
   template<typename Component>
-  void register_component(const std::string& name = std::string(ImInspect::type_name<Component>))
+  void register_component(const std::string& name = std::string(ImInspect::normalized_type_name<Component>))
   {
     for (const auto& comp : mComponents) {
       assert(comp->name != name && "name already registered");
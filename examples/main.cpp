@@ -3,11 +3,14 @@
 #include "imgui_impl_glfw.h"
 #include "imgui_impl_opengl3.h"
 #include <GLFW/glfw3.h>
+#include <atomic>
+#include <chrono>
 #include <enchantum/bitwise_operators.hpp>
 #include <filesystem>
 #include <map>
 #include <optional>
 #include <stdio.h>
+#include <thread>
 #include <tuple>
 #include <variant>
 #include <vector>
@@ -164,9 +167,19 @@ struct B {
 struct A {
   B* b;
 };
+
+// Written by a worker thread and inspected through ImInspect::Snapshot, build with -fsanitize=thread to check it.
+// The worker only writes `tick`, `position` and `samples`, `speed` is left for the UI to edit.
+struct Simulation {
+  int                tick = 0;
+  float              position[2]{};
+  float              speed = 1.0f;
+  std::vector<float> samples;
+};
+
 template<>
 struct ImInspect::inspect<Constructor> {
-  void operator()(Constructor& c, const std::string& name) const { ImGui::DragInt("X", &c.x); }
+  bool operator()(Constructor& c, const ImInspect::Label name) const { return ImGui::DragInt("X", &c.x); }
 };
 
 template<>
@@ -315,6 +328,22 @@ int main()
   editor.register_component<VoidPtr>();
   editor.register_component<LamdbaInName<>>();
 
+  Simulation                      simulation;
+  ImInspect::Snapshot<Simulation> snapshot(simulation);
+  std::atomic<bool>               running = true;
+  std::thread                     worker([&] {
+    while (running.load(std::memory_order_relaxed)) {
+      ++simulation.tick;
+      simulation.position[0] += simulation.speed * 0.01f;
+      simulation.position[1] = static_cast<float>(simulation.tick % 100);
+      simulation.samples.push_back(simulation.position[0]);
+      if (simulation.samples.size() > 256)
+        simulation.samples.erase(simulation.samples.begin());
+      snapshot.sync();
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  });
+
 
   // Main loop
   while (!glfwWindowShouldClose(window)) {
@@ -339,6 +368,10 @@ int main()
     editor.render(registry);
     //editor.draw(registry);
 
+    if (ImGui::Begin("Snapshot"))
+      snapshot.inspect("Simulation");
+    ImGui::End();
+
 
     // Rendering
     ImGui::Render();
@@ -355,6 +388,9 @@ int main()
     glfwSwapBuffers(window);
   }
 
+  running = false;
+  worker.join();
+
   // Cleanup
   ImGui_ImplOpenGL3_Shutdown();
   ImGui_ImplGlfw_Shutdown();
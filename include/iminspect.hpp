@@ -1,18 +1,38 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cfloat>
+#include <charconv>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <enchantum/enchantum.hpp>
 #include <format>
+#include <functional>
 #include <imgui.h>
 #include <imgui_stdlib.h>
 #include <imsweet/raii.hpp>
 #include <lahzam/lahzam.hpp>
+#include <limits>
 #include <locale>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <optional>
 #include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
 #include <typeindex>
 #include <unordered_map>
+#include <utility>
 #include <variant>
+#include <vector>
 
 namespace ImInspect {
 
@@ -31,9 +51,55 @@ struct Style {
 
 Style& GetStyle();
 
-std::string normalize_type_name(std::string_view type_name);
-void        colored_pretty_typename(const std::string& pretty, float indent);
-std::string pretty_typename(const std::string_view type_name);
+struct Config {
+  // Random-access containers with more elements than this are drawn in a scrollable region
+  // where only the visible rows are submitted.
+  std::size_t ClipThreshold = 64;
+  // Height of that region, in rows.
+  int ClipVisibleRows = 16;
+  // Caches kept for a widget (such as iterator checkpoints) are dropped after this many frames without use.
+  int NodeStateLifetime = 60;
+  // Upper bound of the memory used to intern normalized type names, see `normalize_type_name`.
+  std::size_t TypeNameCacheBytes = std::size_t(4) << 20;
+  // Width at which type tooltips wrap long names, 0 uses half of the display width.
+  float TypeTooltipWidth = 0.0f;
+  // Opens every tree node the first time it is drawn, handy for debugging and benchmarks.
+  bool DefaultOpenNodes = false;
+  // Nested values deeper than this are not drawn.
+  int MaxDepth = 32;
+  // Elements summarized per frame for the statistics in "Show Info", larger ranges take several frames.
+  std::size_t StatsSliceSize = std::size_t(1) << 22;
+  // Strings longer than this show a one line preview and open in a paged viewer instead of a text box.
+  std::size_t LargeStringThreshold = 4096;
+  // Debugging aid for editors, asserts that the bytes of every trivially copyable value passed to `do_inspection`
+  // are the same after a call that reported no change. Copies each such value once per nesting level.
+  bool VerifyUntouched = false;
+  // Flashes the rows of values whose content changed since the previous frame, whether the editor or other code
+  // changed them. Nodes with nested values drawn below them, and collapsed ones, flash their first row only.
+  // An expanded container notices changes of the rows it draws, rows clipped out of view are checked once shown.
+  bool HighlightChanges = false;
+  // How long a changed value stays highlighted.
+  float ChangeFlashSeconds = 1.0f;
+  // Read-only values shown as text (`std::formatter`, or a `to_string()` member of a type that is not reflectable)
+  // keep their text while they do not change, and are formatted again at most this many times per second while
+  // they do. 0 formats on every change. `set_next_refresh_rate` sets it for one node.
+  float ReadOnlyRefreshRate = 10.0f;
+};
+
+Config& GetConfig();
+
+// Overrides `Config::ReadOnlyRefreshRate` for the next read-only value shown as text, e.g. one with an expensive
+// `to_string()`. That node keeps the rate while it is shown, a negative rate goes back to the config.
+void set_next_refresh_rate(float rate);
+
+// Normalized `type_name` with user aliases applied, interned in a bounded cache that is safe to use from several threads.
+// The view stays valid until the calling thread starts its next ImGui frame, copy it to keep it for longer.
+std::string_view normalize_type_name(std::string_view type_name);
+void        colored_pretty_typename(std::string_view pretty, float indent);
+// Lays `type_name` out over several lines when it is longer than `max_columns`, one template argument per line.
+// The result is memoized, the view stays valid until the same name is laid out with another width
+// or was not used for `Config::NodeStateLifetime` frames.
+std::string_view pretty_typename(std::string_view type_name, std::size_t max_columns = 130);
 
 template<typename T>
 inline constexpr bool is_opaque_enum = false;
@@ -41,6 +107,19 @@ inline constexpr bool is_opaque_enum = false;
 template<>
 inline constexpr bool is_opaque_enum<std::byte> = true;
 
+// Marks a member as the link to the next node of a singly linked list, such nodes are shown as one flat list
+// walked iteratively instead of pointers nested in each other. Reflectable types with exactly one member
+// linking to their own type (`T*`, `std::unique_ptr<T>` or `std::shared_ptr<T>`) are detected without it.
+//   template<> inline constexpr auto ImInspect::linked_next<Node> = &Node::next;
+template<typename T>
+inline constexpr auto linked_next = nullptr;
+
+// Reflectable types whose members are all vectors of scalars (a struct of arrays) are shown as one table
+// with row i made of the i-th element of every member, as long as the members have the same length.
+// Specialize to false to show such a type member by member.
+template<typename T>
+inline constexpr bool zip_members = true;
+
 std::string_view to_string(const char* s);
 
 template<typename T>
@@ -75,32 +154,709 @@ constexpr auto type_name<volatile T> = type_name<T>;
 template<typename T>
 constexpr auto type_name<const volatile T> = type_name<T>;
 
+namespace details {
+
+  constexpr bool is_identifier_char(const char c)
+  {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '$';
+  }
+
+  // Splits a type name into identifiers and punctuation, whitespace is dropped.
+  // Elaborated type specifiers (`class `, `struct `...) and inline namespaces (`__1::`, `__cxx11::`...) are removed.
+  constexpr std::vector<std::string_view> tokenize_type_name(const std::string_view s)
+  {
+    constexpr std::string_view elaborated[]        = {"class", "struct", "enum", "union"};
+    constexpr std::string_view inline_namespaces[] = {"__1", "__2", "__3", "__4", "__cxx11"};
+
+    std::vector<std::string_view> tokens;
+    for (std::size_t i = 0; i < s.size();) {
+      const char c = s[i];
+      if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+        ++i;
+        continue;
+      }
+
+      std::size_t n = 1;
+      if (details::is_identifier_char(c)) {
+        while (i + n < s.size() && details::is_identifier_char(s[i + n]))
+          ++n;
+      }
+      else if (s.substr(i, 2) == "::" || s.substr(i, 2) == "->") {
+        n = 2;
+      }
+
+      const auto token = s.substr(i, n);
+      i += n;
+
+      if (std::ranges::find(elaborated, token) != std::ranges::end(elaborated))
+        continue;
+      if (std::ranges::find(inline_namespaces, token) != std::ranges::end(inline_namespaces) &&
+          !tokens.empty() && tokens.back() == "::" && s.substr(i).starts_with("::")) {
+        i += 2;
+        continue;
+      }
+      tokens.push_back(token);
+    }
+    return tokens;
+  }
+
+  // Appends `text` to `out`, separating two identifiers with a single space.
+  constexpr void append_type_name_token(std::string& out, const std::string_view text)
+  {
+    if (text.empty())
+      return;
+    if (!out.empty() && details::is_identifier_char(out.back()) && details::is_identifier_char(text.front()))
+      out += ' ';
+    out += text;
+  }
+
+  // Polynomial hash of a token sequence. `power` is base^length so hashes of sequences can be concatenated,
+  // which lets the rewrite rules compare template arguments without re-reading them.
+  struct TypeNameHash {
+    std::uint64_t value = 0;
+    std::uint64_t power = 1;
+
+    constexpr bool operator==(const TypeNameHash&) const = default;
+  };
+
+  inline constexpr std::uint64_t type_name_hash_base = 0x100000001b3ull;
+
+  constexpr std::uint64_t hash_type_name_token(const std::string_view s)
+  {
+    std::uint64_t h = 0xcbf29ce484222325ull;
+    for (const char c : s)
+      h = (h ^ static_cast<unsigned char>(c)) * type_name_hash_base;
+    return h;
+  }
+
+  constexpr TypeNameHash append_type_name_hash(const TypeNameHash h, const std::uint64_t item)
+  {
+    return {h.value * type_name_hash_base + item, h.power * type_name_hash_base};
+  }
+
+  constexpr TypeNameHash concat_type_name_hash(const TypeNameHash a, const TypeNameHash b)
+  {
+    return {a.value * b.power + b.value, a.power * b.power};
+  }
+
+  // Hash of a bracketed item (`<...>`, `(...)`...) from the hashes of its inner sequences.
+  constexpr std::uint64_t hash_type_name_brackets(const std::string_view open,
+                                                  const TypeNameHash*    children,
+                                                  const std::size_t      count,
+                                                  const bool             closed)
+  {
+    auto h = details::hash_type_name_token(open);
+    for (std::size_t i = 0; i < count; ++i) {
+      h = (h ^ children[i].value) * type_name_hash_base;
+      h = (h ^ children[i].power) * type_name_hash_base;
+    }
+    return (h ^ static_cast<std::uint64_t>(closed)) * type_name_hash_base;
+  }
+
+  // Hash of the sequence that `s` tokenizes to.
+  constexpr TypeNameHash hash_type_name_tokens(const std::string_view s)
+  {
+    TypeNameHash h;
+    for (const auto t : details::tokenize_type_name(s))
+      h = details::append_type_name_hash(h, details::hash_type_name_token(t));
+    return h;
+  }
+
+  // Hash of `name<args...>`.
+  constexpr TypeNameHash hash_type_name_template(const std::string_view name, std::initializer_list<TypeNameHash> args)
+  {
+    return details::append_type_name_hash(details::hash_type_name_tokens(name),
+                                          details::hash_type_name_brackets("<", args.begin(), args.size(), true));
+  }
+
+  struct TypeNameRule;
+
+  struct TypeNameItem {
+    enum Kind : unsigned char {
+      Token,
+      Template,
+      Group
+    };
+
+    Kind             kind   = Token;
+    bool             closed = false;
+    std::string_view text; // the token or the opening bracket
+    // Sequences of the template arguments, or the single inner sequence of a group.
+    std::vector<std::uint32_t> children;
+  };
+
+  struct TypeNameSequence {
+    std::vector<TypeNameItem> items;
+    TypeNameHash              hash;
+  };
+
+  // A type name as a tree of token sequences, sequence 0 being the whole name.
+  // Parsing, rewriting and printing are iterative and linear in the length of the name
+  // (rules compare template arguments by hash), so pathological names cannot blow the stack or backtrack.
+  // Unbalanced brackets are kept as they are.
+  struct TypeNameTree {
+    std::vector<TypeNameSequence> sequences;
+
+    constexpr void        parse(std::span<const std::string_view> tokens, std::span<const TypeNameRule> rules);
+    constexpr std::string str() const;
+
+    constexpr std::uint32_t new_sequence()
+    {
+      sequences.emplace_back();
+      return static_cast<std::uint32_t>(sequences.size() - 1);
+    }
+
+    constexpr std::uint64_t hash_item(const TypeNameItem& item) const
+    {
+      if (item.kind == TypeNameItem::Token)
+        return details::hash_type_name_token(item.text);
+
+      std::vector<TypeNameHash> children;
+      children.reserve(item.children.size());
+      for (const auto c : item.children)
+        children.push_back(sequences[c].hash);
+      return details::hash_type_name_brackets(item.text, children.data(), children.size(), item.closed);
+    }
+
+    constexpr void finish_sequence(const std::uint32_t s)
+    {
+      TypeNameHash h;
+      for (const auto& item : sequences[s].items)
+        h = details::append_type_name_hash(h, hash_item(item));
+      sequences[s].hash = h;
+    }
+
+    // Index of the first token of the qualified name right before `items[i]`.
+    constexpr std::size_t qualified_name_begin(const std::uint32_t s, std::size_t i) const
+    {
+      const auto& items    = sequences[s].items;
+      const auto  is_ident = [&](const std::size_t k) {
+        return items[k].kind == TypeNameItem::Token && details::is_identifier_char(items[k].text.front());
+      };
+      const auto is_scope = [&](const std::size_t k) {
+        return items[k].kind == TypeNameItem::Token && items[k].text == "::";
+      };
+
+      if (i == 0 || !is_ident(i - 1))
+        return i;
+      --i;
+      while (i >= 2 && is_scope(i - 1) && is_ident(i - 2))
+        i -= 2;
+      if (i >= 1 && is_scope(i - 1))
+        --i;
+      return i;
+    }
+
+    // Replaces items [first, last] of sequence `s` with the tokens `with` is made of.
+    constexpr void replace_with_tokens(const std::uint32_t s,
+                                       const std::size_t   first,
+                                       const std::size_t   last,
+                                       const std::string_view with)
+    {
+      auto&      items  = sequences[s].items;
+      const auto tokens = details::tokenize_type_name(with);
+
+      std::vector<TypeNameItem> out;
+      out.reserve(items.size() - (last + 1 - first) + tokens.size());
+      for (std::size_t k = 0; k < first; ++k)
+        out.push_back(static_cast<TypeNameItem&&>(items[k]));
+      for (const auto t : tokens)
+        out.push_back({TypeNameItem::Token, true, t, {}});
+      for (std::size_t k = last + 1; k < items.size(); ++k)
+        out.push_back(static_cast<TypeNameItem&&>(items[k]));
+      items = static_cast<std::vector<TypeNameItem>&&>(out);
+    }
+
+    // The tokens sequence `s` is made of, with the brackets of nested lists spelled out. Walked like `str`.
+    constexpr std::vector<std::string_view> tokens_of(const std::uint32_t s) const
+    {
+      struct Frame {
+        std::uint32_t seq;
+        std::size_t   item  = 0;
+        std::size_t   child = 0;
+      };
+
+      std::vector<std::string_view> out;
+      std::vector<Frame>            stack{{s}};
+      while (!stack.empty()) {
+        auto&       f     = stack.back();
+        const auto& items = sequences[f.seq].items;
+        if (f.item == items.size()) {
+          stack.pop_back();
+          continue;
+        }
+
+        const auto& item = items[f.item];
+        if (item.kind == TypeNameItem::Token) {
+          out.push_back(item.text);
+          ++f.item;
+          continue;
+        }
+
+        if (f.child < item.children.size()) {
+          out.push_back(f.child == 0 ? item.text : ",");
+          const auto c = item.children[f.child++];
+          stack.push_back({c});
+          continue;
+        }
+
+        if (item.closed) {
+          const auto open = item.text.front();
+          out.push_back(open == '<' ? ">" : open == '(' ? ")" : open == '[' ? "]" : "}");
+        }
+        ++f.item;
+        f.child = 0;
+      }
+      return out;
+    }
+
+    // Equal hashes are confirmed token by token, a collision must not be taken for the same type.
+    constexpr bool same_sequence(const std::uint32_t a, const std::uint32_t b) const
+    {
+      return sequences[a].hash == sequences[b].hash && (a == b || tokens_of(a) == tokens_of(b));
+    }
+
+    constexpr void drop_default_template_args(std::uint32_t s, std::size_t i, std::size_t name_begin);
+    constexpr bool apply_rule(const TypeNameRule& rule, std::uint32_t s, std::size_t i, std::size_t name_begin);
+    constexpr bool match(const TypeNameTree& pattern, std::uint32_t ps, std::uint32_t s, std::uint32_t* bound) const;
+    constexpr std::uint32_t copy_sequence(const TypeNameTree& from, std::uint32_t fs, const std::uint32_t* bound);
+  };
+
+  // `pattern` is rewritten to `replacement`, both are normalized type names and the pattern has to end with
+  // a template argument list. `$1`...`$9` used as a whole template argument match any argument,
+  // a placeholder that appears twice has to match the same argument.
+  struct TypeNameRule {
+    std::unique_ptr<std::string> text; // owns what the trees point into
+    TypeNameTree                 pattern;
+    TypeNameTree                 replacement;
+  };
+
+  inline constexpr std::uint32_t type_name_unbound = std::uint32_t(-1);
+
+  constexpr int type_name_placeholder(const TypeNameSequence& s)
+  {
+    if (s.items.size() != 1 || s.items[0].kind != TypeNameItem::Token)
+      return -1;
+    const auto t = s.items[0].text;
+    if (t.size() != 2 || t[0] != '$' || t[1] < '1' || t[1] > '9')
+      return -1;
+    return t[1] - '1';
+  }
+
+  constexpr void TypeNameTree::parse(const std::span<const std::string_view> tokens,
+                                     const std::span<const TypeNameRule> rules)
+  {
+    struct Frame {
+      std::uint32_t    seq;
+      std::uint32_t    owner_seq;
+      std::size_t      owner_item;
+      std::string_view close;
+    };
+
+    sequences.clear();
+    new_sequence();
+    std::vector<Frame> stack{{0, 0, 0, ""}};
+
+    for (const auto t : tokens) {
+      const auto top = stack.back();
+      if (stack.size() > 1 && t == top.close) {
+        finish_sequence(top.seq);
+        stack.pop_back();
+        sequences[top.owner_seq].items[top.owner_item].closed = true;
+        if (top.close != ">")
+          continue;
+
+        const auto name_begin = qualified_name_begin(top.owner_seq, top.owner_item);
+        drop_default_template_args(top.owner_seq, top.owner_item, name_begin);
+        for (const auto& rule : rules)
+          if (apply_rule(rule, top.owner_seq, top.owner_item, name_begin))
+            break;
+        continue;
+      }
+
+      if (stack.size() > 1 && top.close == ">" && t == ",") {
+        finish_sequence(top.seq);
+        stack.back().seq = new_sequence();
+        sequences[top.owner_seq].items[top.owner_item].children.push_back(stack.back().seq);
+        continue;
+      }
+
+      const std::string_view close = t == "<" ? ">" : t == "(" ? ")" : t == "[" ? "]" : t == "{" ? "}" : "";
+      if (close.empty()) {
+        sequences[top.seq].items.push_back({TypeNameItem::Token, true, t, {}});
+        continue;
+      }
+
+      const auto kind = t == "<" ? TypeNameItem::Template : TypeNameItem::Group;
+      sequences[top.seq].items.push_back({kind, false, t, {}});
+      const auto item  = sequences[top.seq].items.size() - 1;
+      const auto child = new_sequence();
+      sequences[top.seq].items[item].children.push_back(child);
+      stack.push_back({child, top.seq, item, close});
+    }
+
+    for (; !stack.empty(); stack.pop_back())
+      finish_sequence(stack.back().seq);
+  }
+
+  constexpr std::string TypeNameTree::str() const
+  {
+    struct Frame {
+      std::uint32_t seq;
+      std::size_t   item  = 0;
+      std::size_t   child = 0;
+    };
+
+    std::string        out;
+    std::vector<Frame> stack{{0}};
+    while (!stack.empty()) {
+      auto&       f     = stack.back();
+      const auto& items = sequences[f.seq].items;
+      if (f.item == items.size()) {
+        stack.pop_back();
+        continue;
+      }
+
+      const auto& item = items[f.item];
+      if (item.kind == TypeNameItem::Token) {
+        details::append_type_name_token(out, item.text);
+        ++f.item;
+        continue;
+      }
+
+      if (f.child < item.children.size()) {
+        if (f.child == 0)
+          details::append_type_name_token(out, item.text);
+        else
+          out += ',';
+        const auto c = item.children[f.child++];
+        stack.push_back({c});
+        continue;
+      }
+
+      if (item.closed) {
+        const auto open = item.text.front();
+        out += open == '<' ? '>' : open == '(' ? ')' : open == '[' ? ']' : '}';
+      }
+      ++f.item;
+      f.child = 0;
+    }
+    return out;
+  }
+
+  // Drops the trailing template arguments that are defaulted by the standard library,
+  // e.g. `std::vector<int,std::allocator<int>>` becomes `std::vector<int>`,
+  // and spells `std::basic_string<char>` as `std::string` (same for the other character types and views).
+  constexpr void TypeNameTree::drop_default_template_args(const std::uint32_t s,
+                                                          const std::size_t   i,
+                                                          const std::size_t   name_begin)
+  {
+    if (name_begin == i)
+      return;
+
+    std::string name;
+    for (std::size_t k = name_begin; k < i; ++k)
+      name += sequences[s].items[k].text;
+
+    auto&      args = sequences[s].items[i].children;
+    const auto arg  = [&](const std::size_t k) { return sequences[args[k]].hash; };
+    const auto pop_if = [&](const std::size_t size, const auto is_default) {
+      if (args.size() == size && is_default())
+        args.pop_back();
+    };
+    // the hashes rule out most arguments cheaply, a match is then confirmed against the tokens of the default
+    using Tokens           = std::vector<std::string_view>;
+    const auto template_of = [](const std::string_view t, const std::initializer_list<const Tokens*> of) {
+      auto out = details::tokenize_type_name(t);
+      out.push_back("<");
+      bool first = true;
+      for (const auto a : of) {
+        if (!std::exchange(first, false))
+          out.push_back(",");
+        out.insert(out.end(), a->begin(), a->end());
+      }
+      out.push_back(">");
+      return out;
+    };
+    const auto is = [&](const std::size_t k, const std::string_view t, const std::size_t of) {
+      if (arg(k) != details::hash_type_name_template(t, {arg(of)}))
+        return false;
+      const auto a = tokens_of(args[of]);
+      return tokens_of(args[k]) == template_of(t, {&a});
+    };
+    const auto is_pair_allocator = [&](const std::size_t k) {
+      const auto c         = details::hash_type_name_tokens("const");
+      const auto const_key = details::concat_type_name_hash(c, arg(0));
+      const auto key_const = details::concat_type_name_hash(arg(0), c);
+      const bool const_first =
+        arg(k) == details::hash_type_name_template("std::allocator",
+                                                   {details::hash_type_name_template("std::pair", {const_key, arg(1)})});
+      const bool const_last =
+        arg(k) == details::hash_type_name_template("std::allocator",
+                                                   {details::hash_type_name_template("std::pair", {key_const, arg(1)})});
+      if (!const_first && !const_last)
+        return false;
+
+      const auto value     = tokens_of(args[1]);
+      auto       qualified = tokens_of(args[0]);
+      if (const_first)
+        qualified.insert(qualified.begin(), "const");
+      else
+        qualified.push_back("const");
+      const auto pair = template_of("std::pair", {&qualified, &value});
+      return tokens_of(args[k]) == template_of("std::allocator", {&pair});
+    };
+
+    if (name == "std::vector" || name == "std::deque" || name == "std::list" || name == "std::forward_list") {
+      pop_if(2, [&] { return is(1, "std::allocator", 0); });
+    }
+    else if (name == "std::set" || name == "std::multiset") {
+      pop_if(3, [&] { return is(2, "std::allocator", 0); });
+      pop_if(2, [&] { return is(1, "std::less", 0); });
+    }
+    else if (name == "std::unordered_set" || name == "std::unordered_multiset") {
+      pop_if(4, [&] { return is(3, "std::allocator", 0); });
+      pop_if(3, [&] { return is(2, "std::equal_to", 0); });
+      pop_if(2, [&] { return is(1, "std::hash", 0); });
+    }
+    else if (name == "std::map" || name == "std::multimap") {
+      pop_if(4, [&] { return is_pair_allocator(3); });
+      pop_if(3, [&] { return is(2, "std::less", 0); });
+    }
+    else if (name == "std::unordered_map" || name == "std::unordered_multimap") {
+      pop_if(5, [&] { return is_pair_allocator(4); });
+      pop_if(4, [&] { return is(3, "std::equal_to", 0); });
+      pop_if(3, [&] { return is(2, "std::hash", 0); });
+    }
+    else if (name == "std::stack" || name == "std::queue") {
+      pop_if(2, [&] { return is(1, "std::deque", 0); });
+    }
+    else if (name == "std::priority_queue") {
+      pop_if(3, [&] { return is(2, "std::less", 0); });
+      pop_if(2, [&] { return is(1, "std::vector", 0); });
+    }
+    else if (name == "std::unique_ptr") {
+      pop_if(2, [&] { return is(1, "std::default_delete", 0); });
+    }
+    else if (name == "std::span") {
+      pop_if(2, [&] {
+        const auto extent = tokens_of(args[1]);
+        return extent.size() == 1 && (extent[0] == "18446744073709551615" || extent[0] == "4294967295");
+      });
+    }
+    else if (name == "std::basic_string" || name == "std::basic_string_view") {
+      const bool is_view = name == "std::basic_string_view";
+      if (!is_view)
+        pop_if(3, [&] { return is(2, "std::allocator", 0); });
+      pop_if(2, [&] { return is(1, "std::char_traits", 0); });
+
+      if (args.size() == 1) {
+        constexpr std::string_view chars[][3] = {
+          {"char", "std::string", "std::string_view"},
+          {"wchar_t", "std::wstring", "std::wstring_view"},
+          {"char8_t", "std::u8string", "std::u8string_view"},
+          {"char16_t", "std::u16string", "std::u16string_view"},
+          {"char32_t", "std::u32string", "std::u32string_view"},
+        };
+        for (const auto& c : chars) {
+          const auto& char_type = sequences[args[0]].items;
+          if (char_type.size() == 1 && char_type[0].kind == TypeNameItem::Token && char_type[0].text == c[0]) {
+            replace_with_tokens(s, name_begin, i, is_view ? c[2] : c[1]);
+            return;
+          }
+        }
+      }
+    }
+  }
+
+  constexpr bool TypeNameTree::match(const TypeNameTree&  pattern,
+                                     const std::uint32_t  ps,
+                                     const std::uint32_t  s,
+                                     std::uint32_t* const bound) const
+  {
+    if (const auto p = details::type_name_placeholder(pattern.sequences[ps]); p >= 0) {
+      if (bound[p] == type_name_unbound) {
+        bound[p] = s;
+        return true;
+      }
+      return same_sequence(bound[p], s);
+    }
+
+    const auto& pattern_items = pattern.sequences[ps].items;
+    const auto& items         = sequences[s].items;
+    if (pattern_items.size() != items.size())
+      return false;
+    for (std::size_t k = 0; k < items.size(); ++k) {
+      const auto& a = pattern_items[k];
+      const auto& b = items[k];
+      if (a.kind != b.kind || a.text != b.text || a.closed != b.closed || a.children.size() != b.children.size())
+        return false;
+      for (std::size_t c = 0; c < a.children.size(); ++c)
+        if (!match(pattern, a.children[c], b.children[c], bound))
+          return false;
+    }
+    return true;
+  }
+
+  constexpr std::uint32_t TypeNameTree::copy_sequence(const TypeNameTree&        from,
+                                                      const std::uint32_t        fs,
+                                                      const std::uint32_t* const bound)
+  {
+    if (const auto p = details::type_name_placeholder(from.sequences[fs]); p >= 0 && bound[p] != type_name_unbound)
+      return bound[p];
+
+    const auto s = new_sequence();
+    for (const auto& item : from.sequences[fs].items) {
+      TypeNameItem copy{item.kind, item.closed, item.text, {}};
+      for (const auto c : item.children)
+        copy.children.push_back(copy_sequence(from, c, bound));
+      sequences[s].items.push_back(static_cast<TypeNameItem&&>(copy));
+    }
+    finish_sequence(s);
+    return s;
+  }
+
+  // Applies a user rule to the template argument list `items[i]` of sequence `s`.
+  constexpr bool TypeNameTree::apply_rule(const TypeNameRule& rule,
+                                          const std::uint32_t s,
+                                          const std::size_t   i,
+                                          const std::size_t   name_begin)
+  {
+    const auto& pattern = rule.pattern.sequences[0].items;
+    if (pattern.empty() || pattern.back().kind != TypeNameItem::Template || pattern.size() - 1 != i - name_begin)
+      return false;
+    for (std::size_t k = 0; k + 1 < pattern.size(); ++k)
+      if (pattern[k].kind != TypeNameItem::Token || pattern[k].text != sequences[s].items[name_begin + k].text)
+        return false;
+
+    const auto& args = sequences[s].items[i].children;
+    if (pattern.back().children.size() != args.size())
+      return false;
+
+    std::uint32_t bound[9] = {type_name_unbound,
+                              type_name_unbound,
+                              type_name_unbound,
+                              type_name_unbound,
+                              type_name_unbound,
+                              type_name_unbound,
+                              type_name_unbound,
+                              type_name_unbound,
+                              type_name_unbound};
+    for (std::size_t k = 0; k < args.size(); ++k)
+      if (!match(rule.pattern, pattern.back().children[k], args[k], bound))
+        return false;
+
+    std::vector<TypeNameItem> replacement;
+    for (const auto& item : rule.replacement.sequences[0].items) {
+      TypeNameItem copy{item.kind, item.closed, item.text, {}};
+      for (const auto c : item.children)
+        copy.children.push_back(copy_sequence(rule.replacement, c, bound));
+      replacement.push_back(static_cast<TypeNameItem&&>(copy));
+    }
+
+    auto& items = sequences[s].items;
+    items.erase(items.begin() + static_cast<std::ptrdiff_t>(name_begin), items.begin() + static_cast<std::ptrdiff_t>(i + 1));
+    items.insert(items.begin() + static_cast<std::ptrdiff_t>(name_begin), replacement.begin(), replacement.end());
+    return true;
+  }
+
+  // Compiler independent spelling of a type name: no `class `/`struct ` prefixes, no inline namespaces,
+  // no redundant whitespace and no defaulted standard library template arguments.
+  // `rules` are applied once to every template argument list, innermost first.
+  constexpr std::string normalize_type_name_structurally(const std::string_view         type_name,
+                                                         const std::span<const TypeNameRule> rules = {})
+  {
+    TypeNameTree tree;
+    tree.parse(details::tokenize_type_name(type_name), rules);
+    return tree.str();
+  }
+
+  template<typename T>
+  constexpr auto make_normalized_type_name()
+  {
+    constexpr std::string_view  raw  = type_name<T>;
+    constexpr std::size_t       size = details::normalize_type_name_structurally(raw).size();
+    std::array<char, size + 1> r{};
+    const auto                  s = details::normalize_type_name_structurally(raw);
+    std::ranges::copy(s, r.begin());
+    return r;
+  }
+
+  template<typename T>
+  inline constexpr auto normalized_type_name_storage = details::make_normalized_type_name<T>();
+
+} // namespace details
+
+// `type_name<T>` normalized at compile time, see `details::normalize_type_name_structurally`.
+// User aliases are not applied.
+template<typename T>
+inline constexpr std::string_view normalized_type_name{details::normalized_type_name_storage<T>.data(),
+                                                       details::normalized_type_name_storage<T>.size() - 1};
+
+// Displays every instance of the template `pattern` as `replacement`, e.g.
+// add_type_alias("entt::basic_registry<$1,std::allocator<$1>>", "entt::registry<$1>").
+// `$1`...`$9` stand for whole template arguments, see `details::TypeNameRule`.
+void add_type_alias(std::string_view pattern, std::string_view replacement);
+
+[[deprecated("use add_type_alias, regular expressions cannot match nested template arguments")]]
 void add_regex_alias(std::string_view regex, std::string_view replacement);
+
+namespace details {
+  // Applies the aliases from `add_type_alias` and `add_regex_alias` to an already normalized name.
+  // Returns `normalized` itself when there is nothing to replace.
+  std::string_view with_user_aliases(std::string_view normalized);
+} // namespace details
+
+// Name of an inspected value, a view of a null terminated string so it can be handed to ImGui without a copy.
+// Labels of elements, tuple elements and members are formatted on the stack or at compile time.
+class Label {
+public:
+  constexpr Label() noexcept : Label("", 0) {}
+  constexpr Label(const char* const s) noexcept : str(s), len(std::char_traits<char>::length(s)) {}
+  Label(const std::string& s) noexcept : str(s.c_str()), len(s.size()) {}
+  // `s[size]` has to be '\0'.
+  constexpr Label(const char* const s, const std::size_t size) noexcept : str(s), len(size) {}
+
+  constexpr const char*      c_str() const noexcept { return str; }
+  constexpr std::size_t      size() const noexcept { return len; }
+  constexpr bool             empty() const noexcept { return len == 0; }
+  constexpr std::string_view view() const noexcept { return {str, len}; }
+  constexpr operator std::string_view() const noexcept { return view(); }
+  // Keeps `inspect<T>` specializations taking `const std::string&` working, at the cost of a copy.
+  operator std::string() const { return std::string(view()); }
+
+private:
+  const char* str;
+  std::size_t len;
+};
+
 // Forward declared so they can select the correct overload.
 // sigh this took me a while to understand this is required.
+// Every overload returns true when the user changed the value this frame. Const values can only report changes
+// made through the pointers they hold.
 template<typename T>
-void do_inspection(const T& t, const std::string& name);
+bool do_inspection(const T& t, const Label name);
 template<typename T>
-void do_inspection(T& t, const std::string& name);
-void do_inspection(bool& b, const std::string& name);
-void do_inspection(char& c, const std::string& name);
-void do_inspection(void* p, const std::string& name);
-void do_inspection(const void* p, const std::string& name);
-void do_inspection(volatile void* p, const std::string& name);
-void do_inspection(const volatile void* p, const std::string& name);
-
-void do_inspection(ImVec2& v, const std::string& name);
-void do_inspection(const ImVec2& v, const std::string& name);
-void do_inspection(ImVec4& v, const std::string& name);
-void do_inspection(const ImVec4& v, const std::string& name);
-void do_inspection(ImColor& c, const std::string& name);
-void do_inspection(const ImColor& c, const std::string& name);
-
-void do_inspection(const bool& b, const std::string& name);
-void do_inspection(const char& c, const std::string& name);
-void do_inspection(std::string_view s, const std::string& name);
-void do_inspection(const std::string& s, const std::string& name);
-void do_inspection(std::string& s, const std::string& name);
+bool do_inspection(T& t, const Label name);
+bool do_inspection(bool& b, const Label name);
+bool do_inspection(char& c, const Label name);
+bool do_inspection(void* p, const Label name);
+bool do_inspection(const void* p, const Label name);
+bool do_inspection(volatile void* p, const Label name);
+bool do_inspection(const volatile void* p, const Label name);
+
+bool do_inspection(ImVec2& v, const Label name);
+bool do_inspection(const ImVec2& v, const Label name);
+bool do_inspection(ImVec4& v, const Label name);
+bool do_inspection(const ImVec4& v, const Label name);
+bool do_inspection(ImColor& c, const Label name);
+bool do_inspection(const ImColor& c, const Label name);
+
+bool do_inspection(const bool& b, const Label name);
+bool do_inspection(const char& c, const Label name);
+bool do_inspection(std::string_view s, const Label name);
+bool do_inspection(const std::string& s, const Label name);
+bool do_inspection(std::string& s, const Label name);
 
 
 namespace details {
@@ -134,19 +890,29 @@ namespace details {
   concept AssociativeContainer = requires(T& c, const typename T::key_type& key) { c.at(key); };
 
 
-  void inspect_filesystem_path(void* fs, const std::string& name);
+  bool inspect_filesystem_path(void* fs, const Label name);
 
   bool red_button(const char* name);
   bool green_button(const char* name);
   void grey_button(const char* name, std::string_view tooltip = "");
+  // `name` is expected to be normalized already, see `normalized_type_name`.
   void type_tooltip(std::string_view name, const volatile void* addressof = nullptr);
   void red_tooltip(std::string_view tooltip);
 
-  void display_readonly_data(std::string_view s, const std::string& name);
-  void display_readonly_data(std::string_view s, const std::string& name, const std::string_view type_name);
-
-  void modify_numeric_int(void* p, const std::string& name, std::size_t size, bool is_unsigned, std::string_view type_name);
-  void modify_numeric_float(void* p, const std::string& name, bool is_double, std::string_view type_name);
+  void display_readonly_data(std::string_view s, const Label name);
+  void display_readonly_data(std::string_view s, const Label name, const std::string_view type_name);
+
+  bool modify_numeric_int(void* p, const Label name, std::size_t size, bool is_unsigned, std::string_view type_name);
+  bool modify_numeric_float(void* p, const Label name, bool is_double, std::string_view type_name);
+  // `rows` rows of `columns` scalars stored one row after the other, the label follows the first row.
+  bool modify_numeric_grid(void*            p,
+                           const Label      name,
+                           ImGuiDataType    data_type,
+                           std::size_t      element_size,
+                           int              columns,
+                           int              rows,
+                           bool             read_only,
+                           std::string_view type_name);
 
   void Text(std::string_view s);
 
@@ -157,13 +923,14 @@ namespace details {
 
     details::Text(group_label);
     if (ImGui::IsItemHovered())
-      details::type_tooltip(type_name<E>);
+      details::type_tooltip(normalized_type_name<E>);
     ImGui::SameLine();
-    if (details::red_button("Clear"))
-      enum_flags = E{};
-
     auto flags   = enchantum::to_underlying(enum_flags);
     bool changed = false;
+    if (details::red_button("Clear")) {
+      changed = flags != 0;
+      flags   = 0;
+    }
 
     constexpr auto count           = enchantum::count<E>;
     constexpr auto count_diff_zero = count - enchantum::has_zero_flag<E>;
@@ -187,7 +954,9 @@ namespace details {
       }
     }
 
-    enum_flags = static_cast<E>(flags);
+    // written only when edited, the value may be shared with other threads
+    if (changed)
+      enum_flags = static_cast<E>(flags);
     return changed;
   }
 
@@ -204,7 +973,7 @@ namespace details {
 
     // TODO: figure how to render it on the label
     //if (ImGui::IsItemHovered()) {
-    //details::type_tooltip(type_name<E>);
+    //details::type_tooltip(normalized_type_name<E>);
     //}
     if (const auto listbox = ImSweet::ListBox(label.c_str(),
                                               ImVec2(0, ImGui::GetTextLineHeightWithSpacing() * height_in_items))) {
@@ -225,96 +994,375 @@ namespace details {
   ImGuiDataType_ map_int_type_to_imgui(std::size_t size, bool is_unsigned);
 
   template<typename O>
-  void inspect_optional(O& o, const std::string& name)
+  bool inspect_optional(O& o, const Label name)
   {
     if (o) {
       if constexpr (requires { o.reset(); }) {
         if (details::red_button("-")) {
           o.reset();
-          return;
+          return true;
         }
       }
       else {
         details::grey_button("-", "This optional-like type is does not have `.reset()` function.");
       }
       ImGui::SameLine();
-      ImInspect::do_inspection(*o, name);
+      return ImInspect::do_inspection(*o, name);
     }
     else {
       using ValT = typename O::value_type;
       if constexpr (std::is_default_constructible_v<ValT> && requires { o.emplace(); }) {
         if (details::green_button("+")) {
           o.emplace();
-          return;
+          return true;
         }
       }
       else {
         std::string s = "Cannot create default instance the type is not default-constructible.\n type is ";
-        s += type_name<ValT>;
+        s += normalized_type_name<ValT>;
         details::grey_button("+", s);
       }
       ImGui::SameLine();
-      details::display_readonly_data("none", name, type_name<decltype(o)>);
+      details::display_readonly_data("none", name, normalized_type_name<decltype(o)>);
+      return false;
+    }
+  }
+
+
+  template<typename T, std::size_t... Is>
+  bool inspect_aggregate(T& tuple, std::index_sequence<Is...>, const void* skip = nullptr);
+
+  template<typename M, typename T>
+  inline constexpr bool is_link_to = false;
+
+  template<typename T>
+  inline constexpr bool is_link_to<T*, T> = true;
+
+  template<typename T, typename D>
+  inline constexpr bool is_link_to<std::unique_ptr<T, D>, T> = true;
+
+  template<typename T>
+  inline constexpr bool is_link_to<std::shared_ptr<T>, T> = true;
+
+  // Index of the only member of `T` linking to another `T`, or -1.
+  template<typename T>
+  constexpr std::size_t self_link_member()
+  {
+    if constexpr (!lahzam::reflectable<T>) {
+      return std::size_t(-1);
     }
+    else {
+      return []<std::size_t... Is>(std::index_sequence<Is...>) {
+        constexpr bool links[] = {
+          is_link_to<std::remove_cvref_t<decltype(lahzam::get<Is>(std::declval<T&>()))>, T>..., false};
+
+        std::size_t found = std::size_t(-1), count = 0;
+        for (std::size_t i = 0; i < sizeof...(Is); ++i) {
+          if (links[i]) {
+            found = i;
+            ++count;
+          }
+        }
+        return count == 1 ? found : std::size_t(-1);
+      }(std::make_index_sequence<lahzam::member_count<T>>{});
+    }
+  }
+
+  template<typename T>
+  concept LinkedNode = !std::is_null_pointer_v<std::remove_cv_t<decltype(linked_next<T>)>> ||
+                       details::self_link_member<T>() != std::size_t(-1);
+
+  template<LinkedNode T>
+  auto& next_link(T& node)
+  {
+    if constexpr (!std::is_null_pointer_v<std::remove_cv_t<decltype(linked_next<T>)>>)
+      return node.*linked_next<T>;
+    else
+      return lahzam::get<details::self_link_member<T>()>(node);
+  }
+
+  template<LinkedNode T>
+  T* next_node(T& node)
+  {
+    auto& link = details::next_link(node);
+    if constexpr (std::is_pointer_v<std::remove_cvref_t<decltype(link)>>)
+      return link;
+    else
+      return link.get();
   }
 
+  template<LinkedNode T>
+  bool print_linked_chain(T* head);
 
   inline auto as_void(void* p) { return p; }
   inline auto as_void(const void* p) { return p; }
   inline auto as_void(volatile void* p) { return p; }
   inline auto as_void(const volatile void* p) { return p; }
 
+  // Its address identifies a type at runtime without RTTI.
+  template<typename T>
+  inline char type_tag{};
+
+  // Where the inspection currently is, one per do_inspection call on the stack. It keeps the labels from the root
+  // for the "already shown at" links and enforces `Config::MaxDepth` over all types together.
+  // The outermost scope marks the value at `address` as shown, so pointers back to the root are not expanded.
+  class InspectionScope {
+  public:
+    explicit InspectionScope(Label name, const volatile void* address = nullptr, const void* type = nullptr);
+    ~InspectionScope();
+    InspectionScope(const InspectionScope&)            = delete;
+    InspectionScope& operator=(const InspectionScope&) = delete;
+
+    bool too_deep() const { return deep; }
+
+  private:
+    bool deep;
+  };
+
+  struct ShownPointee {
+    const volatile void* address;
+    const void*          type;
+    Label                path;
+  };
+
+  // Pointees expanded in this frame, keyed by address and type, so cycles and shared pointees are expanded once.
+  // The link to a shown pointee scrolls the window it is drawn in to it in the next frame.
+  const ShownPointee* find_shown_pointee(const volatile void* address, const void* type);
+  void                mark_shown_pointee(const volatile void* address, const void* type);
+  void                shown_pointee_link(Label name, const ShownPointee& shown);
+
+  // Tree node of an inspected value, opened the first time it is seen when `Config::DefaultOpenNodes` is set.
+  inline ImSweet::TreeNode tree_node(const char* const label)
+  {
+    if (GetConfig().DefaultOpenNodes)
+      ImGui::SetNextItemOpen(true, ImGuiCond_Once);
+    return ImSweet::TreeNode(label);
+  }
+
   template<typename P>
-  void inspect_pointer(P& p, const std::string& name)
+  bool inspect_pointer(P& p, const Label name)
   {
     if (p) {
-      const auto tree = ImSweet::TreeNode(name.c_str());
+      using Pointee      = std::remove_cvref_t<decltype(*p)>;
+      const auto address = static_cast<const volatile void*>(std::addressof(*p));
+      if (const auto shown = details::find_shown_pointee(address, &type_tag<Pointee>)) {
+        details::shown_pointee_link(name, *shown);
+        return false;
+      }
+
+      const auto tree = details::tree_node(name.c_str());
       if (ImGui::IsItemHovered())
-        details::type_tooltip(type_name<decltype(p)>);
+        details::type_tooltip(normalized_type_name<decltype(p)>);
       if (tree) {
-        ImInspect::do_inspection(*p, name);
+        details::mark_shown_pointee(address, &type_tag<Pointee>);
+        if constexpr (LinkedNode<Pointee> && !std::is_const_v<std::remove_reference_t<decltype(*p)>>)
+          return details::print_linked_chain(std::addressof(*p));
+        else
+          return ImInspect::do_inspection(*p, name);
       }
     }
     else {
-      details::display_readonly_data(std::string_view("nullptr"), name, type_name<decltype(p)>);
+      details::display_readonly_data(std::string_view("nullptr"), name, normalized_type_name<decltype(p)>);
     }
+    return false;
   }
 
+  // "[i]" formatted on the stack, for the elements of containers.
+  class IndexLabel {
+  public:
+    explicit IndexLabel(const std::size_t i) noexcept
+    {
+      buffer[0]      = '[';
+      const auto end = std::to_chars(buffer + 1, buffer + sizeof(buffer) - 2, i).ptr;
+      end[0]         = ']';
+      end[1]         = '\0';
+      size           = static_cast<std::size_t>(end + 1 - buffer);
+    }
+
+    operator Label() const noexcept { return Label(buffer, size); }
+
+  private:
+    char        buffer[24];
+    std::size_t size;
+  };
+
+  // "(I)" for the elements of tuples.
+  template<std::size_t I>
+  inline constexpr auto tuple_label = [] {
+    std::size_t digits = 1;
+    for (auto v = I; v >= 10; v /= 10)
+      ++digits;
+
+    std::array<char, 24> r{};
+    r[0] = '(';
+    for (std::size_t i = digits, v = I; i != 0; --i, v /= 10)
+      r[i] = static_cast<char>('0' + v % 10);
+    r[digits + 1] = ')';
+    return r;
+  }();
+
+  // Member names of `T` copied into one buffer with a null terminator after each name.
+  template<typename T>
+  inline constexpr auto member_label_storage = [] {
+    constexpr auto size = [] {
+      std::size_t n = 0;
+      for (std::size_t i = 0; i < lahzam::member_count<T>; ++i)
+        n += lahzam::member_names<T>[i].size() + 1;
+      return n;
+    }();
+
+    std::array<char, size> r{};
+    std::size_t            o = 0;
+    for (std::size_t i = 0; i < lahzam::member_count<T>; ++i) {
+      for (const char c : lahzam::member_names<T>[i])
+        r[o++] = c;
+      r[o++] = '\0';
+    }
+    return r;
+  }();
+
+  template<typename T>
+  inline constexpr auto member_labels = [] {
+    std::array<Label, lahzam::member_count<T>> r;
+    std::size_t                                o = 0;
+    for (std::size_t i = 0; i < r.size(); ++i) {
+      const auto size = lahzam::member_names<T>[i].size();
+      r[i]            = Label(member_label_storage<T>.data() + o, size);
+      o += size + 1;
+    }
+    return r;
+  }();
+
   template<typename T, std::size_t... Is>
-  void print_tuple(T& t, const std::string& name, std::index_sequence<Is...>)
+  bool print_tuple(T& t, const Label name, std::index_sequence<Is...>)
   {
-    int        i    = 0;
-    const auto tree = ImSweet::TreeNode(name.c_str());
+    const auto tree = details::tree_node(name.c_str());
     if (ImGui::IsItemHovered()) {
-      details::type_tooltip(type_name<T>);
+      details::type_tooltip(normalized_type_name<T>);
     }
-    if (tree) {
+    if (!tree)
+      return false;
+
+    const auto element = [&t]<std::size_t I>(std::integral_constant<std::size_t, I>) {
       using ::std::get;
-      char c[] = {(ImSweet::ID(i++), ImInspect::do_inspection(get<Is>(t), "(" + std::to_string(Is) + ")"), 0)..., 0};
-      (void)c;
-    }
+      const ImSweet::ID id(static_cast<int>(I));
+      return ImInspect::do_inspection(get<I>(t), details::tuple_label<I>.data());
+    };
+    // every element is drawn, so no short circuiting
+    return (false | ... | element(std::integral_constant<std::size_t, Is>{}));
   }
 
 
-  void display_function_pointer(void (*f)(), const std::string& name, std::string_view type_name);
+  template<typename T>
+  concept CharLike = std::is_same_v<T, char> || std::is_same_v<T, wchar_t> || std::is_same_v<T, char8_t> ||
+                     std::is_same_v<T, char16_t> || std::is_same_v<T, char32_t>;
 
-  template<std::size_t I, typename V>
-  void default_construct_alternative(void* v)
+  // Characters are left out, arrays and tuples of them are shown as text.
+  template<typename T>
+  concept GridScalar = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, long double> &&
+                       !CharLike<T>;
+
+  template<typename T, std::size_t... Is>
+  constexpr bool same_tuple_elements(std::index_sequence<Is...>)
   {
-    using T = std::variant_alternative_t<I, V>;
-    if constexpr (std::is_default_constructible_v<T>)
-      static_cast<V*>(v)->template emplace<T>();
+    return (std::is_same_v<std::tuple_element_t<Is, T>, std::tuple_element_t<0, T>> && ...);
   }
-  template<std::size_t I, typename V>
-  concept CanCallEmplaceAtleastOnce = requires(V& v) { v.template emplace<std::variant_alternative_t<I, V>>(); };
 
-  template<typename V, std::size_t... Is>
-  void print_variant(V& v, const std::string& name, std::index_sequence<Is...>)
-  {
-    using ::std::visit;
+  template<typename T>
+  concept HomogeneousTuple = TupleLike<T> && (std::tuple_size_v<T> > 0) && (std::tuple_size_v<T> <= 8) &&
+                             details::same_tuple_elements<T>(std::make_index_sequence<std::tuple_size_v<T>>{});
 
-    const std::string_view type_names[] = {type_name<std::variant_alternative_t<Is, V>>...};
-    static constexpr bool default_constructible[] = {std::is_default_constructible_v<std::variant_alternative_t<Is, V>>...};
+  // Tuples and std::arrays of up to 8 scalars of one type, drawn as one row of inputs.
+  template<typename T>
+  concept ScalarVector = HomogeneousTuple<T> && GridScalar<std::tuple_element_t<0, T>>;
+
+  // Tuples and std::arrays of up to 8 equal scalar vectors, drawn as a grid with one row per vector.
+  template<typename T>
+  concept ScalarMatrix = HomogeneousTuple<T> && ScalarVector<std::tuple_element_t<0, T>>;
+
+  template<GridScalar S>
+  ImGuiDataType imgui_data_type()
+  {
+    if constexpr (std::is_same_v<S, float>)
+      return ImGuiDataType_Float;
+    else if constexpr (std::is_same_v<S, double>)
+      return ImGuiDataType_Double;
+    else
+      return details::map_int_type_to_imgui(sizeof(S), std::is_unsigned_v<S>);
+  }
+
+  // Calls `f` on every element of `t`, with `get` looked up the same way as in `print_tuple`.
+  template<typename T, typename F>
+  void for_each_tuple_element(T& t, F&& f)
+  {
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      using ::std::get;
+      (f(get<Is>(t)), ...);
+    }(std::make_index_sequence<std::tuple_size_v<std::remove_const_t<T>>>{});
+  }
+
+  // Tuples are not laid out as arrays, so the scalars are copied into one and written back when edited.
+  template<typename T>
+  bool print_scalar_grid(T& t, const Label name)
+  {
+    using V = std::remove_const_t<T>;
+    using R = std::conditional_t<ScalarMatrix<V>, std::tuple_element_t<0, V>, V>;
+    using S = std::tuple_element_t<0, R>;
+
+    constexpr std::size_t columns = std::tuple_size_v<R>;
+    constexpr std::size_t rows    = ScalarMatrix<V> ? std::tuple_size_v<V> : 1;
+
+    std::array<S, rows * columns> values;
+    const auto                    for_each_scalar = [&t](auto&& f) {
+      const auto row = [&f](auto& r) { details::for_each_tuple_element(r, f); };
+      if constexpr (ScalarMatrix<V>)
+        details::for_each_tuple_element(t, row);
+      else
+        row(t);
+    };
+
+    std::size_t i = 0;
+    for_each_scalar([&](const S& e) { values[i++] = e; });
+
+    const bool changed = details::modify_numeric_grid(values.data(),
+                                                      name,
+                                                      details::imgui_data_type<S>(),
+                                                      sizeof(S),
+                                                      static_cast<int>(columns),
+                                                      static_cast<int>(rows),
+                                                      std::is_const_v<T>,
+                                                      normalized_type_name<V>);
+    if constexpr (!std::is_const_v<T>) {
+      if (changed) {
+        i = 0;
+        for_each_scalar([&](S& e) { e = values[i++]; });
+      }
+    }
+    return changed;
+  }
+
+
+  void display_function_pointer(void (*f)(), const Label name, std::string_view type_name);
+
+  template<std::size_t I, typename V>
+  void default_construct_alternative(void* v)
+  {
+    using T = std::variant_alternative_t<I, V>;
+    if constexpr (std::is_default_constructible_v<T>)
+      static_cast<V*>(v)->template emplace<T>();
+  }
+  template<std::size_t I, typename V>
+  concept CanCallEmplaceAtleastOnce = requires(V& v) { v.template emplace<std::variant_alternative_t<I, V>>(); };
+
+  template<typename V, std::size_t... Is>
+  bool print_variant(V& v, const Label name, std::index_sequence<Is...>)
+  {
+    using ::std::visit;
+
+    bool constructed = false;
+
+    const std::string_view type_names[] = {normalized_type_name<std::variant_alternative_t<Is, V>>...};
+    static constexpr bool default_constructible[] = {std::is_default_constructible_v<std::variant_alternative_t<Is, V>>...};
 
     if constexpr ((CanCallEmplaceAtleastOnce<Is, V> || ...)) {
       const auto non_templated = [&](const std::string_view n) {
@@ -329,16 +1377,18 @@ namespace details {
           for (std::size_t i = 0; i < sizeof...(Is); ++i) {
             bool              is_selected = n == type_names[i];
             const ImSweet::ID id(static_cast<int>(i));
-            const auto        s = ImInspect::normalize_type_name(type_names[i]);
+            const auto        s = details::with_user_aliases(type_names[i]);
 
             if (default_constructible[i]) {
               const bool clicked = ImGui::Selectable("", is_selected);
               ImInspect::colored_pretty_typename(s, 0.0f);
-              if (clicked)
+              if (clicked) {
                 constructors[i](static_cast<void*>(&v));
+                constructed = true;
+              }
             }
             else {
-              ImGui::TextDisabled("%s", s.data());
+              ImGui::TextDisabled("%.*s", static_cast<int>(s.size()), s.data());
               if (ImGui::IsItemHovered()) {
                 details::red_tooltip("This alternative is not default-constructible!");
               }
@@ -349,7 +1399,7 @@ namespace details {
         }
       };
 
-      visit([&non_templated](auto& e) { non_templated(type_name<std::remove_cvref_t<decltype(e)>>); }, v);
+      visit([&non_templated](auto& e) { non_templated(normalized_type_name<std::remove_cvref_t<decltype(e)>>); }, v);
     }
     else {
       const auto non_templated = [&](const std::string_view n) {
@@ -363,9 +1413,9 @@ namespace details {
           for (std::size_t i = 0; i < sizeof...(Is); ++i) {
             bool              is_selected = n == type_names[i];
             const ImSweet::ID id(static_cast<int>(i));
-            const auto        s = ImInspect::normalize_type_name(type_names[i]);
+            const auto        s = details::with_user_aliases(type_names[i]);
 
-            ImGui::TextDisabled("%s", s.data());
+            ImGui::TextDisabled("%.*s", static_cast<int>(s.size()), s.data());
             if (ImGui::IsItemHovered()) {
               details::red_tooltip("This alternative is not default-constructible!");
             }
@@ -373,50 +1423,1178 @@ namespace details {
         }
       };
 
-      visit([&non_templated](auto& e) { non_templated(type_name<decltype(e)>); }, v);
+      visit([&non_templated](auto& e) { non_templated(normalized_type_name<decltype(e)>); }, v);
+    }
+
+    return visit(
+             [&name](auto& e) {
+               ImGui::SameLine();
+               return ImInspect::do_inspection(e, name);
+             },
+             v) ||
+           constructed;
+  }
+
+  // Memory for text that only has to live until the end of the frame, rewound at the start of the next frame
+  // so formatting values does not go through the global heap. There is one per thread, like the ImGui context.
+  std::pmr::memory_resource& frame_memory();
+
+  // Copies `s` into the frame memory with a null terminator.
+  Label frame_string(std::string_view s);
+
+  // Formats into the frame memory with a null terminator.
+  template<typename... Args>
+  Label frame_format(const std::format_string<Args...> fmt, Args&&... args)
+  {
+    const auto  size = std::formatted_size(fmt, args...);
+    auto* const p    = static_cast<char*>(details::frame_memory().allocate(size + 1, alignof(char)));
+    std::format_to(p, fmt, args...);
+    p[size] = '\0';
+    return Label(p, size);
+  }
+
+  // State that has to survive across frames for one widget, such as caches.
+  // Keyed by ImGuiID, entries not touched for `Config::NodeStateLifetime` frames are dropped.
+  struct NodeState {
+    virtual ~NodeState() = default;
+  };
+
+  NodeState* find_node_state(ImGuiID id, const void* type);
+  NodeState& emplace_node_state(ImGuiID id, const void* type, std::unique_ptr<NodeState> state);
+
+  template<typename S>
+  S& node_state(const ImGuiID id)
+  {
+    static_assert(std::is_base_of_v<NodeState, S>);
+    if (const auto s = details::find_node_state(id, &type_tag<S>))
+      return static_cast<S&>(*s);
+    return static_cast<S&>(details::emplace_node_state(id, &type_tag<S>, std::make_unique<S>()));
+  }
+
+  // Index based access into a node based container without walking from `begin()` every frame.
+  // Every `stride`th iterator is remembered as a checkpoint and so is the last visited one,
+  // so consecutive rows cost a single increment and a jump costs at most `2 * stride` increments.
+  // Everything is thrown away once the container moves, changes size or rehashes. An erase and an insert that keep
+  // the size are caught where they moved the checkpoint a jump lands on, which is walked to again from the one before.
+  template<typename C>
+  struct CheckpointedCursor : NodeState {
+    using Iter = std::ranges::iterator_t<C>;
+
+    static constexpr std::size_t stride = 256;
+
+    const void*       container    = nullptr;
+    std::size_t       size         = 0;
+    std::size_t       bucket_count = 0;
+    std::vector<Iter> checkpoints;
+    Iter              last{};
+    std::size_t       last_index = 0;
+    int               last_frame = -1;
+
+    // Returns true when the container changed and the checkpoints were dropped.
+    bool sync(C& c)
+    {
+      std::size_t buckets = 0;
+      if constexpr (requires { c.bucket_count(); })
+        buckets = c.bucket_count();
+
+      const auto begin = std::ranges::begin(c);
+      const auto count = static_cast<std::size_t>(std::ranges::size(c));
+      if (container == std::addressof(c) && size == count && bucket_count == buckets && !checkpoints.empty() &&
+          checkpoints.front() == begin)
+        return false;
+
+      container    = std::addressof(c);
+      size         = count;
+      bucket_count = buckets;
+      checkpoints.assign(1, begin);
+      last_frame = -1;
+      return true;
+    }
+
+    void invalidate() { checkpoints.clear(); }
+
+    Iter seek(const std::size_t i)
+    {
+      assert(i < size && !checkpoints.empty());
+      // the last visited row is only trusted in the frame it was reached in
+      const int  frame = ImGui::GetFrameCount();
+      const bool near  = last_frame == frame && i >= last_index && i - last_index < stride;
+      if (near && i == last_index)
+        return last;
+
+      Iter        it;
+      std::size_t at;
+      if (near) {
+        it = last;
+        at = last_index;
+      }
+      else {
+        const auto k = std::min(i / stride, checkpoints.size() - 1);
+        if (k != 0) {
+          it = checkpoints[k - 1];
+          for (std::size_t n = 0; n < stride; ++n)
+            ++it;
+          if (it != checkpoints[k]) {
+            checkpoints.resize(k + 1);
+            checkpoints[k] = it;
+          }
+        }
+        it = checkpoints[k];
+        at = k * stride;
+      }
+
+      while (at < i) {
+        ++it;
+        ++at;
+        if (at % stride == 0 && at / stride == checkpoints.size())
+          checkpoints.push_back(it);
+      }
+
+      last       = it;
+      last_index = i;
+      last_frame = frame;
+      return it;
+    }
+  };
+
+  bool begin_clipped_region(std::size_t count);
+  void end_clipped_region();
+
+  // Heights of the rows of a clipped region. Most rows are as high as the first one drawn, `usual`, only the rows
+  // drawn taller or shorter, such as an expanded tree node, are kept, so finding a row costs a step per such row.
+  struct RowHeights : NodeState {
+    float                        usual = 0;
+    std::map<std::size_t, float> uneven;
+
+    // Distance from the top of the region to row `i`.
+    float offset(std::size_t i, float row) const;
+    // The row at distance `y` from the top and its offset.
+    std::pair<std::size_t, float> row_at(float y, std::size_t count, float row) const;
+    void                          measured(std::size_t i, float height, float row);
+    void                          resize(std::size_t count) { uneven.erase(uneven.lower_bound(count), uneven.end()); }
+  };
+
+  // Calls `draw_row(i)` only for the rows of [0, count) that are currently visible.
+  // Above `Config::ClipThreshold` the rows live in their own scrollable child, below it every row is drawn inline.
+  // Rows may have different heights, e.g. expanded elements, the height of every drawn row is remembered and the rows
+  // above and below the visible ones are skipped by moving the cursor.
+  // `draw_row` returns true to stop early, e.g. after the container was modified.
+  // `scroll_to` brings that row into view in this frame.
+  template<typename F>
+  void for_each_visible_row(const std::size_t count, F&& draw_row, const std::size_t scroll_to = std::size_t(-1))
+  {
+    if (count <= ImInspect::GetConfig().ClipThreshold) {
+      for (std::size_t i = 0; i < count; ++i) {
+        if (i == scroll_to)
+          ImGui::SetScrollHereY(0.0f);
+        if (draw_row(i))
+          return;
+      }
+      return;
     }
 
-    visit(
-      [&name](auto& e) {
-        ImGui::SameLine();
-        ImInspect::do_inspection(e, name);
-      },
-      v);
+    if (details::begin_clipped_region(count)) {
+      auto&       heights = details::node_state<RowHeights>(ImGui::GetID("##heights"));
+      const float row     = heights.usual > 0 ? heights.usual : ImGui::GetFrameHeightWithSpacing();
+      const float top     = ImGui::GetCursorPosY();
+      heights.resize(count);
+      if (scroll_to < count)
+        ImGui::SetScrollY(heights.offset(scroll_to, row));
+
+      const float visible_end = ImGui::GetScrollY() + ImGui::GetWindowHeight() - top;
+      auto [i, y]             = heights.row_at(ImGui::GetScrollY() - top, count, row);
+      for (; i < count && y < visible_end; ++i) {
+        ImGui::SetCursorPosY(top + y);
+        if (draw_row(i)) {
+          details::end_clipped_region();
+          return;
+        }
+        const float height = ImGui::GetCursorPosY() - top - y;
+        heights.measured(i, height, row);
+        y += height;
+      }
+      // the rows below are not drawn, the cursor is moved past them so the region scrolls over all of them
+      ImGui::SetCursorPosY(top + heights.offset(count, row));
+      ImGui::Dummy(ImVec2(0, 0));
+    }
+    details::end_clipped_region();
+  }
+
+  // Key of a map entry as a label, keys that have to be formatted are formatted into the frame memory.
+  template<typename K>
+  Label key_label(const K& k)
+  {
+    if constexpr (std::is_same_v<K, std::string>) {
+      return k;
+    }
+    else if constexpr (requires { std::formatter<K>{}; } && !std::is_enum_v<K> && !requires { k.to_string(); }) {
+      return details::frame_format("{}", k);
+    }
+    else {
+      using ImInspect::to_string;
+      return details::frame_string(to_string(k));
+    }
+  }
+
+  // Keys that can be typed into the "seek to key" box of ordered maps.
+  template<typename K>
+  concept SeekableKey = std::is_constructible_v<K, std::string_view> || (std::is_arithmetic_v<K> && !std::is_same_v<K, bool>);
+
+  template<SeekableKey K>
+  std::optional<K> parse_key(const std::string_view text)
+  {
+    if constexpr (std::is_constructible_v<K, std::string_view>) {
+      return K(text);
+    }
+    else {
+      K          k{};
+      const auto r = std::from_chars(text.data(), text.data() + text.size(), k);
+      if (r.ec != std::errc{})
+        return std::nullopt;
+      return k;
+    }
+  }
+
+  template<typename C>
+  concept OrderedAssociativeContainer = requires(C& c, const typename C::key_type& key) {
+    c.lower_bound(key);
+    c.key_comp();
+  } && SeekableKey<typename C::key_type>;
+
+  // Rows of a map, iterated from checkpoints, with the formatted keys cached by node.
+  // A cached key is reformatted when its node holds another key, all of them are dropped when the size changes.
+  template<typename C>
+  struct AssociativeView : CheckpointedCursor<C> {
+    using Key = typename C::key_type;
+
+    static constexpr bool compare_keys = std::copyable<Key> && std::equality_comparable<Key>;
+
+    struct CachedKey {
+      std::conditional_t<compare_keys, std::optional<Key>, bool> key{};
+      std::string                                                text;
+    };
+
+    std::unordered_map<const void*, CachedKey> keys;
+    std::string                                seek_text;
+    std::size_t                                scroll_to = std::size_t(-1);
+
+    void sync(C& c)
+    {
+      if (CheckpointedCursor<C>::sync(c))
+        keys.clear();
+    }
+
+    Label key_label(const Key& k)
+    {
+      if constexpr (std::is_same_v<Key, std::string>) {
+        return k;
+      }
+      else {
+        // only the visible rows are looked up, keep about that many
+        const auto& config = ImInspect::GetConfig();
+        if (keys.size() > 4 * (config.ClipThreshold + static_cast<std::size_t>(config.ClipVisibleRows)))
+          keys.clear();
+
+        auto [it, inserted] = keys.try_emplace(std::addressof(k));
+        auto& cached        = it->second;
+        bool  stale         = inserted;
+        if constexpr (compare_keys)
+          stale = stale || !(*cached.key == k);
+        if (stale) {
+          cached.text = details::key_label(k).view();
+          if constexpr (compare_keys)
+            cached.key = k;
+        }
+        return cached.text;
+      }
+    }
+
+    // Index of the first entry whose key is not less than `key`, walked from the closest checkpoint.
+    std::size_t index_of_lower_bound(C& c, const Key& key)
+    {
+      const auto target = c.lower_bound(key);
+      const auto comp   = c.key_comp();
+      const auto first  = std::ranges::partition_point(
+        this->checkpoints, [&](const auto& it) { return it != std::ranges::end(c) && !comp(key, it->first); });
+
+      auto k = static_cast<std::size_t>(first - this->checkpoints.begin());
+      k      = k == 0 ? 0 : k - 1;
+
+      auto        it = this->checkpoints[k];
+      std::size_t at = k * this->stride;
+      for (; it != target; ++it, ++at)
+        if (at % this->stride == 0 && at / this->stride == this->checkpoints.size())
+          this->checkpoints.push_back(it);
+      return at;
+    }
+  };
+
+  template<typename C>
+  bool print_asscoiative_range(C& c, const Label name)
+  {
+    bool       changed     = false;
+    const auto print_entry = [&changed](auto&& entry, const std::size_t i, const Label key) {
+      auto&& [k, v] = entry;
+      ImSweet::ID id(static_cast<int>(i));
+      changed |= ImInspect::do_inspection(v, key);
+      return false;
+    };
+
+    if constexpr (std::ranges::sized_range<C>) {
+      const ImSweet::ID id(name.c_str());
+      auto&             view = details::node_state<AssociativeView<C>>(ImGui::GetID("##rows"));
+      view.sync(c);
+
+      if constexpr (OrderedAssociativeContainer<C>) {
+        if (view.size > ImInspect::GetConfig().ClipThreshold &&
+            ImGui::InputTextWithHint("##seek", "Seek to key", &view.seek_text, ImGuiInputTextFlags_EnterReturnsTrue)) {
+          if (const auto key = details::parse_key<typename C::key_type>(view.seek_text))
+            view.scroll_to = std::min(view.index_of_lower_bound(c, *key), view.size - 1);
+        }
+      }
+
+      const auto scroll_to = std::exchange(view.scroll_to, std::size_t(-1));
+      details::for_each_visible_row(
+        view.size,
+        [&](const std::size_t i) {
+          auto&& entry = *view.seek(i);
+          return print_entry(entry, i, view.key_label(entry.first));
+        },
+        scroll_to);
+    }
+    else {
+      auto       begin = std::ranges::begin(c);
+      const auto end   = std::ranges::end(c);
+      for (std::size_t i = 0; begin != end; ++begin, ++i)
+        print_entry(*begin, i, details::key_label(begin->first));
+    }
+    return changed;
+  }
+
+  template<typename Iter, typename Sen, std::size_t... Is>
+  bool print_range(Iter begin, const Sen end, const Label name)
+  {
+    bool changed = false;
+    if constexpr (std::random_access_iterator<Iter> && std::sized_sentinel_for<Sen, Iter>) {
+      details::for_each_visible_row(static_cast<std::size_t>(end - begin), [&](const std::size_t i) {
+        ImSweet::ID id(static_cast<int>(i));
+        changed |=
+          ImInspect::do_inspection(begin[static_cast<std::iter_difference_t<Iter>>(i)], details::IndexLabel(i));
+        return false;
+      });
+    }
+    else {
+      int i = 0;
+      for (; begin != end; ++begin) {
+        ImSweet::ID id(i);
+        changed |= ImInspect::do_inspection(*begin, details::IndexLabel(i));
+        ++i;
+      }
+    }
+    return changed;
+  }
+
+  void print_more_container_info(std::size_t count);
+
+  // Draws the erase button and the element itself, returns true if `it` was erased.
+  // `changed` is set when the element was erased or edited.
+  template<typename C, typename Iter>
+  bool print_container_element(C& c, const Iter it, const std::size_t i, bool& changed)
+  {
+    ImSweet::ID id(static_cast<int>(i));
+
+    if constexpr (requires { c.erase(it); }) {
+      if (details::red_button("-")) {
+        c.erase(it);
+        changed = true;
+        return true;
+      }
+    }
+    else {
+      details::grey_button("-", "This container does not support erasing elements.");
+    }
+
+    ImGui::SameLine();
+    changed |= ImInspect::do_inspection(*it, details::IndexLabel(i));
+    return false;
+  }
+
+  // Scalars that fit in one table cell.
+  template<typename T>
+  concept TableCell = (std::is_arithmetic_v<T> && !std::is_same_v<T, long double>) || std::is_enum_v<T>;
+
+  template<typename T, std::size_t... Is>
+  constexpr bool all_members_are_cells(std::index_sequence<Is...>)
+  {
+    return (TableCell<std::remove_cvref_t<decltype(lahzam::get<Is>(std::declval<T&>()))>> && ...);
+  }
+
+  // Aggregates of scalars, a range of them is drawn as a table with one column per member.
+  template<typename T>
+  concept TableRow = lahzam::reflectable<T> && (lahzam::member_count<T> > 0) && (lahzam::member_count<T> < 64) &&
+                     details::all_members_are_cells<T>(std::make_index_sequence<lahzam::member_count<T>>{});
+
+  // Draws `v` filling its table cell, returns true when it was edited.
+  template<typename T>
+  bool table_cell(T& v)
+  {
+    using V = std::remove_const_t<T>;
+
+    if constexpr (std::is_const_v<T>) {
+      if constexpr (std::is_enum_v<V> && !is_opaque_enum<V> && !enchantum::is_bitflag<V>)
+        details::Text(enchantum::to_string(v));
+      else if constexpr (std::is_enum_v<V>)
+        details::Text(details::frame_format("{}", +static_cast<std::underlying_type_t<V>>(v)));
+      else if constexpr (std::is_same_v<V, bool>)
+        details::Text(v ? "true" : "false");
+      else
+        details::Text(details::frame_format("{}", +v));
+      return false;
+    }
+    else if constexpr (std::is_same_v<V, bool>) {
+      return ImGui::Checkbox("##v", &v);
+    }
+    else if constexpr (std::is_enum_v<V> && !is_opaque_enum<V> && !enchantum::is_bitflag<V>) {
+      bool changed = false;
+      ImGui::SetNextItemWidth(-FLT_MIN);
+      if (ImGui::BeginCombo("##v", details::frame_string(enchantum::to_string(v)).c_str())) {
+        for (std::size_t i = 0; i < enchantum::count<V>; ++i) {
+          const bool is_selected = enchantum::values<V>[i] == v;
+          if (ImGui::Selectable(enchantum::names<V>[i].data(), is_selected)) {
+            v       = enchantum::values<V>[i];
+            changed = true;
+          }
+          if (is_selected)
+            ImGui::SetItemDefaultFocus();
+        }
+        ImGui::EndCombo();
+      }
+      return changed;
+    }
+    else if constexpr (std::is_enum_v<V>) {
+      auto u = static_cast<std::underlying_type_t<V>>(v);
+      ImGui::SetNextItemWidth(-FLT_MIN);
+      if (!ImGui::InputScalar("##v", details::map_int_type_to_imgui(sizeof(u), std::is_unsigned_v<decltype(u)>), &u))
+        return false;
+      v = V(u);
+      return true;
+    }
+    else if constexpr (std::is_floating_point_v<V>) {
+      ImGui::SetNextItemWidth(-FLT_MIN);
+      if constexpr (std::is_same_v<V, double>)
+        return ImGui::InputDouble("##v", &v);
+      else
+        return ImGui::InputFloat("##v", &v);
+    }
+    else {
+      ImGui::SetNextItemWidth(-FLT_MIN);
+      return ImGui::InputScalar("##v", details::map_int_type_to_imgui(sizeof(V), std::is_unsigned_v<V>), &v);
+    }
+  }
+
+  // The rows of a table over a random access range of aggregates, one column per member.
+  template<typename C>
+  struct AggregateRows {
+    using Row = std::remove_reference_t<std::ranges::range_reference_t<C>>;
+
+    static constexpr std::size_t columns = lahzam::member_count<std::remove_cv_t<Row>>;
+
+    C& c;
+
+    std::size_t size() const { return static_cast<std::size_t>(std::ranges::size(c)); }
+    const void* data() const { return size() != 0 ? std::addressof(*std::ranges::begin(c)) : nullptr; }
+
+    template<std::size_t I>
+    auto& cell(const std::size_t row) const
+    {
+      return lahzam::get<I>(std::ranges::begin(c)[static_cast<std::ranges::range_difference_t<C>>(row)]);
+    }
+
+    static Label column_name(const std::size_t i) { return details::member_labels<std::remove_cv_t<Row>>[i]; }
+  };
+
+  // Sort order of a table as a permutation of its rows. It is rebuilt only when the sort specs change, rows are
+  // added, removed or moved, a cell is edited in the table, or values changed by other code broke the order.
+  // The latter is noticed by comparing `checked_per_frame` neighbouring rows per frame in turn.
+  struct TableOrder : NodeState {
+    static constexpr std::size_t checked_per_frame = std::size_t(1) << 14;
+
+    struct SortColumn {
+      std::size_t column;
+      bool        descending;
+    };
+
+    std::vector<std::uint32_t> rows; // empty while unsorted
+    std::vector<SortColumn>    sort;
+    const void*                data       = nullptr;
+    std::size_t                size       = 0;
+    std::size_t                next_check = 0;
+    bool                       dirty      = true;
+    bool                       editing    = false;
+  };
+
+  // Calls `f(std::integral_constant<std::size_t, I>{})` for I == column.
+  template<typename F, std::size_t... Is>
+  void visit_column(const std::size_t column, F&& f, std::index_sequence<Is...>)
+  {
+    (void)((column == Is ? (f(std::integral_constant<std::size_t, Is>{}), true) : false) || ...);
+  }
+
+  // Whether row `a` comes before row `b` in the sort order. NaNs come last in either direction and rows that
+  // compare equal keep their order, so this is a strict weak ordering for every column type.
+  template<typename Rows>
+  bool row_before(const Rows& rows, const TableOrder& order, const std::uint32_t a, const std::uint32_t b)
+  {
+    for (const auto& s : order.sort) {
+      int  r   = 0;
+      bool nan = false;
+      details::visit_column(
+        s.column,
+        [&](const auto I) {
+          const auto& x = rows.template cell<I>(a);
+          const auto& y = rows.template cell<I>(b);
+          if constexpr (std::is_floating_point_v<std::remove_cvref_t<decltype(x)>>) {
+            if (std::isnan(x) || std::isnan(y)) {
+              nan = true;
+              r   = std::isnan(x) - std::isnan(y);
+              return;
+            }
+          }
+          r = x < y ? -1 : y < x ? 1 : 0;
+        },
+        std::make_index_sequence<Rows::columns>{});
+      if (r != 0)
+        return nan || !s.descending ? r < 0 : r > 0;
+    }
+    return a < b;
+  }
+
+  template<typename Rows>
+  void sort_table(const Rows& rows, TableOrder& order)
+  {
+    if (order.sort.empty()) {
+      order.rows.clear();
+      return;
+    }
+
+    order.rows.resize(rows.size());
+    for (std::size_t i = 0; i < order.rows.size(); ++i)
+      order.rows[i] = static_cast<std::uint32_t>(i);
+
+    std::ranges::sort(order.rows, [&](const std::uint32_t a, const std::uint32_t b) {
+      return details::row_before(rows, order, a, b);
+    });
+  }
+
+  // Compares the next slice of neighbouring rows, true when two of them are out of order.
+  template<typename Rows>
+  bool order_broken(const Rows& rows, TableOrder& order)
+  {
+    if (order.rows.size() < 2)
+      return false;
+
+    for (std::size_t n = std::min(TableOrder::checked_per_frame, order.rows.size() - 1); n != 0; --n) {
+      if (order.next_check + 1 >= order.rows.size())
+        order.next_check = 0;
+      const auto k = order.next_check++;
+      if (!details::row_before(rows, order, order.rows[k], order.rows[k + 1]))
+        return true;
+    }
+    return false;
+  }
+
+  // Returns true when a cell of the row is being edited, `changed` is set when one was changed.
+  template<typename Rows, std::size_t... Is>
+  bool print_table_row(const Rows& rows, const std::size_t row, bool& changed, std::index_sequence<Is...>)
+  {
+    bool active = false;
+    auto cell   = [&](auto& v, const int column) {
+      ImGui::TableNextColumn();
+      const ImSweet::ID id(column);
+      changed |= details::table_cell(v);
+      active |= ImGui::IsItemActive();
+      return '\0';
+    };
+    const char c[] = {cell(rows.template cell<Is>(row), static_cast<int>(Is))..., 0};
+    (void)c;
+    return active;
+  }
+
+  // Draws `rows` as a table with one editable column per member, sorted by clicking the headers.
+  // Only the visible rows are submitted. `erase(i)` removes the row i, pass nullptr when rows cannot be removed.
+  // Returns true when a row was edited or erased.
+  template<typename Rows, typename Erase>
+  bool print_table(const Rows& rows, Erase&& erase)
+  {
+    const auto  count  = rows.size();
+    const auto& config = ImInspect::GetConfig();
+    const auto  shown  = std::min(count, static_cast<std::size_t>(config.ClipVisibleRows));
+    const float height = ImGui::GetFrameHeightWithSpacing() * static_cast<float>(shown + 1);
+
+    auto& order = details::node_state<TableOrder>(ImGui::GetID("##order"));
+
+    const auto table = ImSweet::Table("##table",
+                                      static_cast<int>(Rows::columns + 1),
+                                      ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY |
+                                        ImGuiTableFlags_Resizable | ImGuiTableFlags_Sortable |
+                                        ImGuiTableFlags_SortMulti | ImGuiTableFlags_SortTristate,
+                                      ImVec2(0, height));
+    if (!table)
+      return false;
+
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("#", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_NoSort);
+    for (std::size_t i = 0; i < Rows::columns; ++i)
+      ImGui::TableSetupColumn(Rows::column_name(i).c_str());
+    ImGui::TableHeadersRow();
+
+    if (ImGuiTableSortSpecs* const specs = ImGui::TableGetSortSpecs(); specs && specs->SpecsDirty) {
+      order.sort.clear();
+      for (int i = 0; i < specs->SpecsCount; ++i) {
+        const auto& s = specs->Specs[i];
+        order.sort.push_back({static_cast<std::size_t>(s.ColumnIndex - 1),
+                              s.SortDirection == ImGuiSortDirection_Descending});
+      }
+      specs->SpecsDirty = false;
+      order.dirty       = true;
+    }
+
+    // rows do not move under the cell that is being typed into, an edit re-sorts once it is done
+    if (!order.dirty && !order.editing && order.data == rows.data() && order.size == count)
+      order.dirty = details::order_broken(rows, order);
+    if ((order.dirty && !order.editing) || order.data != rows.data() || order.size != count) {
+      details::sort_table(rows, order);
+      order.data  = rows.data();
+      order.size  = count;
+      order.dirty = false;
+    }
+
+    bool             editing = false;
+    bool             changed = false;
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(count));
+    while (clipper.Step()) {
+      for (int r = clipper.DisplayStart; r < clipper.DisplayEnd; ++r) {
+        const auto i = order.rows.empty() ? static_cast<std::size_t>(r) : std::size_t(order.rows[r]);
+
+        const ImSweet::ID id(static_cast<int>(i));
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        if constexpr (!std::is_null_pointer_v<std::remove_cvref_t<Erase>>) {
+          if (details::red_button("-")) {
+            erase(i);
+            return true;
+          }
+          ImGui::SameLine();
+        }
+        ImGui::Text("%zu", i);
+
+        editing |= details::print_table_row(rows, i, changed, std::make_index_sequence<Rows::columns>{});
+      }
+    }
+    order.editing = editing;
+    order.dirty |= changed && !order.sort.empty();
+    return changed;
+  }
+
+  // Columns of a struct of arrays, resizable ranges of scalars. Strings and fixed size arrays are left out.
+  template<typename R>
+  concept CellColumn = std::ranges::random_access_range<R> && std::ranges::sized_range<R> &&
+                       std::is_lvalue_reference_v<std::ranges::range_reference_t<R>> &&
+                       TableCell<std::remove_cvref_t<std::ranges::range_reference_t<R>>> &&
+                       !CharLike<std::remove_cvref_t<std::ranges::range_reference_t<R>>> &&
+                       !requires { std::tuple_size<std::remove_cv_t<R>>::value; };
+
+  template<typename T, std::size_t... Is>
+  constexpr bool all_members_are_columns(std::index_sequence<Is...>)
+  {
+    return (CellColumn<std::remove_reference_t<decltype(lahzam::get<Is>(std::declval<T&>()))>> && ...);
+  }
+
+  template<typename T>
+  concept StructOfArrays = zip_members<T> && lahzam::reflectable<T> && (lahzam::member_count<T> > 1) &&
+                           (lahzam::member_count<T> < 64) &&
+                           details::all_members_are_columns<T>(std::make_index_sequence<lahzam::member_count<T>>{});
+
+  // The rows of a table over a struct of arrays, row i is the i-th element of every member.
+  template<typename T>
+  struct ZippedRows {
+    static constexpr std::size_t columns = lahzam::member_count<std::remove_cv_t<T>>;
+
+    T& t;
+
+    std::size_t size() const { return static_cast<std::size_t>(std::ranges::size(lahzam::get<0>(t))); }
+    const void* data() const { return size() != 0 ? std::addressof(cell<0>(0)) : nullptr; }
+
+    template<std::size_t I>
+    auto& cell(const std::size_t row) const
+    {
+      auto& column = lahzam::get<I>(t);
+      return std::ranges::begin(column)[static_cast<std::ranges::range_difference_t<decltype(column)>>(row)];
+    }
+
+    static Label column_name(const std::size_t i) { return details::member_labels<std::remove_cv_t<T>>[i]; }
+  };
+
+  // Draws the members of `t` zipped into one table, returns false when they do not have the same length.
+  // `changed` is set when a row was edited or erased.
+  template<typename T, std::size_t... Is>
+  bool print_struct_of_arrays(T& t, bool& changed, std::index_sequence<Is...>)
+  {
+    const ZippedRows<T> rows{t};
+    const auto          count = rows.size();
+    if (((static_cast<std::size_t>(std::ranges::size(lahzam::get<Is>(t))) != count) || ...))
+      return false;
+
+    if constexpr ((requires { lahzam::get<Is>(t).erase(std::ranges::begin(lahzam::get<Is>(t))); } && ...)) {
+      changed = details::print_table(rows, [&t](const std::size_t i) {
+        const auto erase = [i](auto& column) {
+          column.erase(std::ranges::begin(column) +
+                       static_cast<std::ranges::range_difference_t<decltype(column)>>(i));
+        };
+        (erase(lahzam::get<Is>(t)), ...);
+      });
+    }
+    else {
+      changed = details::print_table(rows, nullptr);
+    }
+    return true;
+  }
+
+  // Smallest and largest value over a run of elements, NaNs are skipped.
+  // Extremes of finite values, NaNs and infinities (also doubles out of the range of float) are left out.
+  struct MinMax {
+    float lo = std::numeric_limits<float>::infinity();
+    float hi = -std::numeric_limits<float>::infinity();
+
+    void add(const float v)
+    {
+      if (!std::isfinite(v))
+        return;
+      lo = v < lo ? v : lo;
+      hi = v > hi ? v : hi;
+    }
+    void add(const MinMax m)
+    {
+      lo = std::min(lo, m.lo);
+      hi = std::max(hi, m.hi);
+    }
+    bool empty() const { return !(lo <= hi); }
+  };
+
+  enum class RangeView { Rows, Plot, Histogram, Heatmap };
+
+  // Min/max pyramid over a contiguous range of numbers with the views drawn from it.
+  // Level 0 summarizes blocks of `block` elements and every level above halves the one below,
+  // so the extremes of any run are known after O(log n) steps. It is built once, after that `scan_budget`
+  // elements are rehashed every frame and only blocks whose hash changed are summarized again,
+  // so a write shows up at most `size / scan_budget` frames later. The histogram and the heatmap are computed
+  // again in passes of about `scan_budget` elements per frame, the previous result is drawn until a pass is done.
+  struct NumericSummary : NodeState {
+    static constexpr std::size_t block       = 64;
+    static constexpr std::size_t scan_budget = std::size_t(1) << 16;
+
+    int view = static_cast<int>(RangeView::Rows);
+
+    std::size_t                      size = 0;
+    std::vector<std::uint64_t>       hashes; // one per block
+    std::vector<std::vector<MinMax>> levels;
+    std::size_t                      next_scan = 0;
+    std::uint64_t                    version   = 0; // bumped whenever a summary changed
+
+    // what the views draw, recomputed when `version` or their layout changes
+    std::vector<MinMax> columns;
+    std::vector<float>  bins;
+    std::vector<float>  cells;
+    std::uint64_t       columns_version = std::uint64_t(-1);
+    std::uint64_t       bins_version    = std::uint64_t(-1);
+    std::uint64_t       cells_version   = std::uint64_t(-1);
+    MinMax              bins_bounds;
+    int                 heat_width    = 0;
+    int                 cells_width   = 0;
+    int                 cells_height  = 0;
+    int                 cells_columns = 0;
+    int                 cells_rows    = 0;
+
+    // the pass in progress, `*_pass` is the version it started from or -1 when there is none
+    std::vector<float> pass_bins;
+    std::vector<float> pass_cells;
+    std::uint64_t      bins_pass  = std::uint64_t(-1);
+    std::uint64_t      cells_pass = std::uint64_t(-1);
+    std::size_t        bins_done  = 0;
+    std::size_t        cells_done = 0; // rows of the data
+    MinMax             pass_bounds;
+    int                pass_width   = 0;
+    std::size_t        pass_height  = 0; // rows of the data
+    int                pass_columns = 0;
+    int                pass_rows    = 0;
+
+    MinMax bounds() const { return levels.empty() || levels.back().empty() ? MinMax{} : levels.back().front(); }
+
+    void rebuild_levels();
+    void update_block(std::size_t b, MinMax m);
+
+    template<typename S>
+    static std::pair<std::uint64_t, MinMax> scan_block(const std::span<const S> data, const std::size_t b)
+    {
+      const auto    first = b * block;
+      const auto    last  = std::min(first + block, data.size());
+      std::uint64_t h     = 0xcbf29ce484222325;
+      MinMax        m;
+      for (auto i = first; i < last; ++i) {
+        std::uint64_t bits = 0;
+        std::memcpy(&bits, &data[i], sizeof(S));
+        h = (h ^ bits) * 0x100000001b3;
+        m.add(static_cast<float>(data[i]));
+      }
+      return {h, m};
+    }
+
+    template<typename S>
+    void sync(const std::span<const S> data)
+    {
+      const auto blocks = (data.size() + block - 1) / block;
+      if (data.size() != size || levels.empty()) {
+        // whole blocks from before are kept, the scan below catches them if they changed too
+        const auto kept = std::min(size / block, blocks);
+        size            = data.size();
+        hashes.resize(blocks);
+        levels.resize(1);
+        levels[0].resize(blocks);
+        for (auto b = kept; b < blocks; ++b)
+          std::tie(hashes[b], levels[0][b]) = scan_block(data, b);
+        rebuild_levels();
+        next_scan = 0;
+        ++version;
+      }
+
+      bool changed = false;
+      for (std::size_t n = std::min(blocks, scan_budget / block); n != 0; --n) {
+        const auto b = next_scan;
+        next_scan    = (next_scan + 1) % blocks;
+
+        const auto [h, m] = scan_block(data, b);
+        if (h != hashes[b]) {
+          hashes[b] = h;
+          update_block(b, m);
+          changed = true;
+        }
+      }
+      if (changed)
+        ++version;
+    }
+
+    // Extremes of [first, last).
+    template<typename S>
+    MinMax query(const std::span<const S> data, std::size_t first, std::size_t last) const
+    {
+      MinMax m;
+      while (first < last && first % block != 0)
+        m.add(static_cast<float>(data[first++]));
+      while (last > first && last % block != 0 && last != data.size())
+        m.add(static_cast<float>(data[--last]));
+
+      if (first == last)
+        return m;
+
+      // a partial last block is summarized like a whole one
+      first /= block;
+      last = (last + block - 1) / block;
+      for (std::size_t level = 0; first < last; ++level, first /= 2, last /= 2) {
+        if (first % 2 != 0)
+          m.add(levels[level][first++]);
+        if (last % 2 != 0)
+          m.add(levels[level][--last]);
+      }
+      return m;
+    }
+  };
+
+  void range_view_selector(int& view);
+  void draw_min_max_plot(std::span<const MinMax> columns, MinMax bounds, std::size_t count);
+  void draw_histogram(std::span<const float> bins, MinMax bounds, std::size_t count);
+  void draw_heatmap(std::span<const float> cells, int columns, int rows, MinMax bounds, int width, int height);
+
+  template<typename C>
+  concept PlottableRange = std::ranges::contiguous_range<C> && std::ranges::sized_range<C> &&
+                           GridScalar<std::ranges::range_value_t<C>>;
+
+  // Plot, histogram and heatmap of a contiguous range of numbers, each drawn from the min/max pyramid
+  // with about as many shapes as the view has pixels. Returns false while the rows are shown instead.
+  template<PlottableRange C>
+  bool print_numeric_views(C& c)
+  {
+    using S = std::ranges::range_value_t<C>;
+
+    auto& summary = details::node_state<NumericSummary>(ImGui::GetID("##summary"));
+    details::range_view_selector(summary.view);
+    if (summary.view == static_cast<int>(RangeView::Rows))
+      return false;
+
+    const std::span<const S> data(std::ranges::data(c), static_cast<std::size_t>(std::ranges::size(c)));
+    summary.sync(data);
+
+    const auto  count = data.size();
+    const float width = std::max(ImGui::GetContentRegionAvail().x, 1.0f);
+    switch (static_cast<RangeView>(summary.view)) {
+      case RangeView::Plot: {
+        const auto columns = std::min(count, static_cast<std::size_t>(width));
+        if (summary.columns_version != summary.version || summary.columns.size() != columns) {
+          summary.columns.resize(columns);
+          for (std::size_t x = 0; x < columns; ++x)
+            summary.columns[x] = summary.query(data, x * count / columns, (x + 1) * count / columns);
+          summary.columns_version = summary.version;
+        }
+        details::draw_min_max_plot(summary.columns, summary.bounds(), count);
+        break;
+      }
+      case RangeView::Histogram: {
+        if (summary.bins_pass == std::uint64_t(-1) && summary.bins_version != summary.version) {
+          summary.bins_pass   = summary.version;
+          summary.pass_bounds = summary.bounds();
+          summary.bins_done   = 0;
+          summary.pass_bins.assign(64, 0.0f);
+        }
+        if (summary.bins_pass != std::uint64_t(-1)) {
+          const auto bounds = summary.pass_bounds;
+          const auto last   = std::min(count, summary.bins_done + NumericSummary::scan_budget);
+          if (!bounds.empty()) {
+            // in double so nothing overflows, values changed since the pass started may fall outside the bounds
+            auto&        bins  = summary.pass_bins;
+            const double lo    = bounds.lo;
+            const double scale = bounds.hi > bounds.lo ? double(bins.size()) / (double(bounds.hi) - lo) : 0.0;
+            const double top   = double(bins.size() - 1);
+            for (auto i = summary.bins_done; i < last; ++i) {
+              const float f = static_cast<float>(data[i]);
+              if (std::isfinite(f))
+                bins[static_cast<std::size_t>(std::clamp((double(f) - lo) * scale, 0.0, top))] += 1;
+            }
+          }
+          summary.bins_done = last;
+          if (last >= count) {
+            std::swap(summary.bins, summary.pass_bins);
+            summary.bins_bounds  = bounds;
+            summary.bins_version = summary.bins_pass;
+            summary.bins_pass    = std::uint64_t(-1);
+          }
+        }
+        details::draw_histogram(summary.bins, summary.bins_bounds, count);
+        break;
+      }
+      case RangeView::Heatmap: {
+        if (summary.heat_width <= 0)
+          summary.heat_width = std::max(1, static_cast<int>(std::sqrt(static_cast<double>(count))));
+        ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8);
+        if (ImGui::InputInt("Width", &summary.heat_width))
+          summary.heat_width = std::clamp(summary.heat_width, 1, static_cast<int>(std::max<std::size_t>(count, 1)));
+
+        const auto w       = static_cast<std::size_t>(summary.heat_width);
+        const auto h       = (count + w - 1) / w;
+        const auto columns = static_cast<int>(std::clamp(static_cast<std::size_t>(width / 4), std::size_t(1), w));
+        const auto rows    = static_cast<int>(std::min(h, static_cast<std::size_t>(80)));
+
+        const bool layout_changed = summary.pass_width != summary.heat_width || summary.pass_height != h ||
+                                    summary.pass_columns != columns || summary.pass_rows != rows;
+        if ((summary.cells_pass == std::uint64_t(-1) && summary.cells_version != summary.version) || layout_changed) {
+          summary.cells_pass   = summary.version;
+          summary.cells_done   = 0;
+          summary.pass_width   = summary.heat_width;
+          summary.pass_height  = h;
+          summary.pass_columns = columns;
+          summary.pass_rows    = rows;
+          summary.pass_cells.assign(static_cast<std::size_t>(columns) * rows, std::numeric_limits<float>::quiet_NaN());
+        }
+        if (summary.cells_pass != std::uint64_t(-1)) {
+          // every cell is the largest value of the block of the data it covers, filled one row of the data at a
+          // time until the budget is spent, a query costs about as much as reading the elements it covers
+          std::size_t budget = NumericSummary::scan_budget;
+          std::size_t r      = summary.cells_done;
+          for (; r < h && budget != 0; ++r) {
+            const auto y = static_cast<std::size_t>(r * static_cast<std::size_t>(rows) / h);
+            for (int x = 0; x < columns; ++x) {
+              const auto first = std::min(r * w + x * w / columns, count);
+              const auto last  = std::min(r * w + (x + 1) * w / columns, count);
+              if (first >= last)
+                continue;
+              const auto m    = summary.query(data, first, last);
+              auto&      cell = summary.pass_cells[y * columns + x];
+              if (!m.empty())
+                cell = std::isnan(cell) ? m.hi : std::max(cell, m.hi);
+              budget -= std::min(budget, std::min(last - first, 2 * NumericSummary::block));
+            }
+          }
+          summary.cells_done = r;
+          if (r >= h) {
+            std::swap(summary.cells, summary.pass_cells);
+            summary.cells_version = summary.cells_pass;
+            summary.cells_width   = summary.pass_width;
+            summary.cells_height  = static_cast<int>(h);
+            summary.cells_columns = summary.pass_columns;
+            summary.cells_rows    = summary.pass_rows;
+            summary.cells_pass    = std::uint64_t(-1);
+          }
+        }
+        if (summary.cells.empty())
+          ImGui::ProgressBar(static_cast<float>(summary.cells_done) / static_cast<float>(std::max<std::size_t>(h, 1)));
+        else
+          details::draw_heatmap(summary.cells,
+                                summary.cells_columns,
+                                summary.cells_rows,
+                                summary.bounds(),
+                                summary.cells_width,
+                                summary.cells_height);
+        break;
+      }
+      default:
+        break;
+    }
+    return true;
+  }
+
+  // Running statistics of numbers. Sums are of the values minus `shift`, one of the values,
+  // so the variance does not cancel out for data far from zero. NaNs and infinities are only counted.
+  struct NumericStats {
+    std::size_t finite      = 0;
+    std::size_t nan         = 0;
+    std::size_t inf         = 0;
+    double      lo          = std::numeric_limits<double>::infinity();
+    double      hi          = -std::numeric_limits<double>::infinity();
+    double      sum         = 0;
+    double      sum_squares = 0;
+  };
+
+  template<typename S>
+  void accumulate_stats(NumericStats& s, const S* const p, const std::size_t n, const double shift)
+  {
+    for (std::size_t i = 0; i < n; ++i) {
+      const auto v = static_cast<double>(p[i]);
+      if (std::isnan(v)) {
+        ++s.nan;
+      }
+      else if (std::isinf(v)) {
+        ++s.inf;
+      }
+      else {
+        ++s.finite;
+        s.lo         = std::min(s.lo, v);
+        s.hi         = std::max(s.hi, v);
+        const auto d = v - shift;
+        s.sum += d;
+        s.sum_squares += d * d;
+      }
+    }
+  }
+
+  // Vectorized with AVX or SSE2 when the library is compiled for them.
+  void accumulate_stats(NumericStats& s, const float* p, std::size_t n, double shift);
+  void accumulate_stats(NumericStats& s, const double* p, std::size_t n, double shift);
+
+  // Statistics of a contiguous range of numbers for "Show Info", computed `Config::StatsSliceSize` elements
+  // per frame so a huge range does not stall the frame. The result is kept for as long as the range has
+  // the same data pointer and size, or until refreshed.
+  struct ContainerStats : NodeState {
+    const void*           data = nullptr;
+    std::size_t           size = 0;
+    std::size_t           done = 0; // elements through the current pass
+    bool                  binning = false; // second pass, filling the histogram
+    bool                  ready   = false;
+    double                shift   = 0;
+    NumericStats          stats;
+    std::array<float, 32> bins{};
+
+    template<typename S>
+    void reset(const std::span<const S> values)
+    {
+      data    = values.data();
+      size    = values.size();
+      done    = 0;
+      binning = false;
+      ready   = false;
+      shift   = !values.empty() && std::isfinite(static_cast<double>(values[0])) ? static_cast<double>(values[0]) : 0;
+      stats   = {};
+      bins.fill(0);
+    }
+  };
+
+  void print_container_stats(ContainerStats& stats);
+  void print_memory_info(std::size_t element_size, std::size_t size, std::size_t capacity);
+
+  template<typename S>
+  void update_container_stats(ContainerStats& s, const std::span<const S> data)
+  {
+    if (s.data != data.data() || s.size != data.size())
+      s.reset(data);
+
+    for (auto budget = ImInspect::GetConfig().StatsSliceSize; budget != 0 && !s.ready;) {
+      const auto n = std::min(budget, data.size() - s.done);
+      const S*   p = data.data() + s.done;
+      if (!s.binning) {
+        details::accumulate_stats(s.stats, p, n, s.shift);
+      }
+      else if (s.stats.finite != 0) {
+        const double range = s.stats.hi - s.stats.lo;
+        const double scale = range > 0 ? static_cast<double>(s.bins.size()) / range : 0.0;
+        const double top   = static_cast<double>(s.bins.size() - 1);
+        for (std::size_t i = 0; i < n; ++i) {
+          const auto v = static_cast<double>(p[i]);
+          if (!std::isfinite(v))
+            continue;
+          // values changed since the first pass may fall outside [lo, hi], a NaN from an overflow lands in bin 0
+          const double at = (v - s.stats.lo) * scale;
+          s.bins[at > 0 ? static_cast<std::size_t>(std::min(at, top)) : 0] += 1;
+        }
+      }
+      s.done += n;
+      budget -= n;
+
+      if (s.done == data.size()) {
+        s.ready   = s.binning;
+        s.binning = true;
+        s.done    = 0;
+      }
+    }
   }
 
-  template<typename Iter, typename Sen, std::size_t... Is>
-  void print_asscoiative_range(Iter begin, const Sen end, const std::string& name)
+  template<PlottableRange C>
+  void print_numeric_stats(C& c)
   {
-    for (int i = 0; begin != end; ++begin) {
-      auto&& [k, v] = *begin;
-      ImSweet::ID id(i++);
-      using ImInspect::to_string;
-      auto&& s = to_string(k);
-      ImInspect::do_inspection(v, static_cast<const std::string&>(s));
-    }
+    auto& stats = details::node_state<ContainerStats>(ImGui::GetID("##stats"));
+    details::update_container_stats(stats,
+                                    std::span<const std::ranges::range_value_t<C>>(
+                                      std::ranges::data(c), static_cast<std::size_t>(std::ranges::size(c))));
+    details::print_container_stats(stats);
   }
 
-  template<typename Iter, typename Sen, std::size_t... Is>
-  void print_range(Iter begin, const Sen end, const std::string& name)
+  template<typename T>
+  concept ByteLike = std::is_same_v<T, std::byte> || std::is_same_v<T, unsigned char>;
+
+  template<typename C>
+  concept ByteRange = std::ranges::contiguous_range<C> && std::ranges::sized_range<C> &&
+                      ByteLike<std::ranges::range_value_t<C>>;
+
+  // Hex dump of a byte buffer, 16 bytes per row with only the visible rows drawn, with a search for
+  // hex or text patterns. The clicked byte can be edited unless the bytes are const, returns true when it was.
+  bool print_hex_view(std::span<unsigned char> bytes);
+  bool print_hex_view(std::span<const unsigned char> bytes);
+
+  template<ByteRange C>
+  auto byte_span(C& c)
   {
-    int i = 0;
-    for (; begin != end; ++begin) {
-      ImSweet::ID id(i);
-      ImInspect::do_inspection(*begin, "[" + std::to_string(i) + "]");
-      ++i;
-    }
+    using B = std::conditional_t<std::is_const_v<std::remove_reference_t<std::ranges::range_reference_t<C>>>,
+                                 const unsigned char,
+                                 unsigned char>;
+    return std::span<B>(reinterpret_cast<B*>(std::ranges::data(c)), static_cast<std::size_t>(std::ranges::size(c)));
   }
 
-  void print_more_container_info(std::size_t count);
-
   template<typename C>
-  void print_container(C& c, const std::string& name)
+  bool print_container(C& c, const Label name)
   {
     static_assert(std::ranges::range<C>);
 
-    const auto tree = ImSweet::TreeNode(name.c_str());
+    const auto tree = details::tree_node(name.c_str());
     if (ImGui::IsItemHovered())
-      details::type_tooltip(type_name<C>);
+      details::type_tooltip(normalized_type_name<C>);
+    bool changed = false;
     if (tree) {
 
       if (ImGui::Button("Show Info")) {
@@ -425,6 +2603,15 @@ namespace details {
 
       if (const auto popup = ImSweet::Popup("InfoPopup")) {
         details::print_more_container_info(std::ranges::size(c));
+        if constexpr (std::ranges::contiguous_range<C> && std::ranges::sized_range<C>) {
+          std::size_t capacity = std::size_t(-1);
+          if constexpr (requires { c.capacity(); })
+            capacity = static_cast<std::size_t>(c.capacity());
+          details::print_memory_info(
+            sizeof(std::ranges::range_value_t<C>), static_cast<std::size_t>(std::ranges::size(c)), capacity);
+        }
+        if constexpr (details::PlottableRange<C>)
+          details::print_numeric_stats(c);
       }
 
       ImGui::SameLine();
@@ -432,76 +2619,461 @@ namespace details {
       if constexpr (requires { c.emplace_back(); } && std::is_default_constructible_v<typename C::value_type>) {
         if (details::green_button(creation_button_name)) {
           c.emplace_back();
+          changed = true;
         }
       }
       else {
         details::grey_button(creation_button_name, "This container does not emplacing elements at the end.");
       }
 
-      auto       begin = std::ranges::begin(c);
-      const auto end   = std::ranges::end(c);
-
-      for (int i = 0; begin != end; ++begin, ++i) {
-        ImSweet::ID id(i);
-
-        if constexpr (requires { c.erase(begin); }) {
-          if (details::red_button("-")) {
-            c.erase(begin);
-            break;
-          }
+      if constexpr (details::ByteRange<C>) {
+        changed |= details::print_hex_view(details::byte_span(c));
+      }
+      else if constexpr (std::ranges::random_access_range<C> && std::ranges::sized_range<C> &&
+                         details::TableRow<std::remove_cvref_t<std::ranges::range_reference_t<C>>>) {
+        const details::AggregateRows<C> rows{c};
+        if constexpr (requires { c.erase(std::ranges::begin(c)); }) {
+          changed |= details::print_table(rows, [&c](const std::size_t i) {
+            c.erase(std::ranges::begin(c) + static_cast<std::ranges::range_difference_t<C>>(i));
+          });
         }
         else {
-          details::grey_button("-", "This container does not support erasing elements.");
+          changed |= details::print_table(rows, nullptr);
+        }
+      }
+      else if constexpr (std::ranges::random_access_range<C> && std::ranges::sized_range<C>) {
+        if constexpr (details::PlottableRange<C>) {
+          if (details::print_numeric_views(c))
+            return changed;
         }
+        details::for_each_visible_row(std::ranges::size(c), [&](const std::size_t i) {
+          const auto it = std::ranges::begin(c) + static_cast<std::ranges::range_difference_t<C>>(i);
+          return details::print_container_element(c, it, i, changed);
+        });
+      }
+      else if constexpr (std::ranges::sized_range<C>) {
+        auto& cursor = details::node_state<CheckpointedCursor<C>>(ImGui::GetID("##rows"));
+        cursor.sync(c);
+        details::for_each_visible_row(cursor.size, [&](const std::size_t i) {
+          if (!details::print_container_element(c, cursor.seek(i), i, changed))
+            return false;
+          cursor.invalidate();
+          return true;
+        });
+      }
+      else {
+        auto       begin = std::ranges::begin(c);
+        const auto end   = std::ranges::end(c);
 
-        ImGui::SameLine();
-        ImInspect::do_inspection(*begin, "[" + std::to_string(i) + "]");
+        for (std::size_t i = 0; begin != end; ++begin, ++i) {
+          if (details::print_container_element(c, begin, i, changed))
+            break;
+        }
       }
     }
+    return changed;
   }
 
+  // `skip` is the address of a member left out, such as the link of a node shown in a list.
   template<typename T, std::size_t... Is>
-  void inspect_aggregate(T& tuple, std::index_sequence<Is...>)
+  bool inspect_aggregate(T& tuple, std::index_sequence<Is...>, const void* const skip)
   {
-    auto f = [](auto& e, const std::size_t i) {
+    bool changed = false;
+    auto f       = [skip, &changed](auto& e, const std::size_t i) {
+      if (static_cast<const void*>(std::addressof(e)) == skip)
+        return '\0';
+
       ImSweet::ID id(i);
-      const auto  n = lahzam::member_names<T>[i];
+      const auto  n = details::member_labels<T>[i];
       using E       = std::remove_cvref_t<decltype(e)>;
       if constexpr (lahzam::reflectable<E>) {
         if constexpr (lahzam::member_count<E> > 1) {
-          const auto tree = ImSweet::TreeNode(n.data());
+          const auto tree = details::tree_node(n.c_str());
           if (ImGui::IsItemHovered()) {
-            details::type_tooltip(type_name<E>);
+            details::type_tooltip(normalized_type_name<E>);
           }
           if (tree) {
-            ImInspect::do_inspection(e, "");
+            changed |= ImInspect::do_inspection(e, "");
           }
         }
         else {
-          ImInspect::do_inspection(e, std::string(n));
+          changed |= ImInspect::do_inspection(e, n);
         }
       }
       else {
-        ImInspect::do_inspection(e, std::string(n));
+        changed |= ImInspect::do_inspection(e, n);
       }
       return '\0';
     };
     const char c[] = {f(lahzam::get<Is>(tuple), Is)..., 0};
     (void)c;
+    return changed;
+  }
+
+  // What is known about a linked list reachable from one head. The program may free any node between frames, so no
+  // node is kept from one frame to the next: every frame walks from the head down to the visible rows and counts on for
+  // at most `counted_per_frame` more nodes. A longer chain is known as far as the walks reached, scrolling down to the
+  // last known row reaches further.
+  template<typename T>
+  struct LinkedChain : NodeState {
+    static constexpr std::size_t counted_per_frame = std::size_t(1) << 14;
+
+    std::size_t size        = 0;
+    std::size_t cycle_start = std::size_t(-1);
+    bool        complete    = false;
+  };
+
+  // One walk of a linked list from its head within a frame, with constant memory even when it loops back on itself.
+  // Brent's algorithm, the node saved at every power of two is met again once the walk went around a cycle.
+  template<typename T>
+  struct ChainWalk {
+    T*          head;
+    T*          node;
+    std::size_t index       = 0;
+    std::size_t end         = std::size_t(-1);
+    std::size_t cycle_start = std::size_t(-1);
+    T*          saved       = nullptr;
+    std::size_t saved_index = 0;
+    std::size_t limit       = 1;
+
+    explicit ChainWalk(T* const first) : head(first), node(first)
+    {
+      if (first == nullptr)
+        end = 0;
+    }
+
+    // The node at `i`, which is not before the one last asked for, nullptr past the end of the chain.
+    T* seek(const std::size_t i)
+    {
+      while (index < i && step()) {}
+      return index == i && i < end ? node : nullptr;
+    }
+
+    // Moves to the next node, false once the end of the chain is known.
+    bool step()
+    {
+      if (index >= end)
+        return false;
+
+      node = details::next_node(*node);
+      ++index;
+      if (node == nullptr) {
+        end = index;
+        return false;
+      }
+      if (node == saved) {
+        const auto cycle_length = index - saved_index;
+
+        T* a = head;
+        T* b = head;
+        for (std::size_t i = 0; i < cycle_length; ++i)
+          b = details::next_node(*b);
+        std::size_t start = 0;
+        for (; a != b; ++start) {
+          a = details::next_node(*a);
+          b = details::next_node(*b);
+        }
+
+        cycle_start = start;
+        end         = start + cycle_length;
+        return false;
+      }
+      if (index == limit) {
+        saved       = node;
+        saved_index = index;
+        limit *= 2;
+      }
+      return true;
+    }
+  };
+
+  // Draws a linked list as one clipped list of nodes, without recursing from node to node.
+  // Reflectable nodes are drawn without their link, other nodes go through `inspect<T>` which should not follow it.
+  template<LinkedNode T>
+  bool print_linked_chain(T* const head)
+  {
+    auto&                 chain = details::node_state<LinkedChain<T>>(ImGui::GetID("##chain"));
+    details::ChainWalk<T> walk(head);
+
+    bool changed = false;
+    if (chain.complete)
+      ImGui::TextDisabled("%zu nodes", chain.size);
+    else
+      ImGui::TextDisabled("%zu+ nodes", chain.size);
+    details::for_each_visible_row(chain.size, [&](const std::size_t i) {
+      T* const node = walk.seek(i);
+      if (node == nullptr)
+        return true;
+
+      const ImSweet::ID              id(static_cast<int>(i));
+      const details::IndexLabel      label(i);
+      const details::InspectionScope scope(label);
+      const auto                     tree = details::tree_node(Label(label).c_str());
+      if (tree) {
+        if constexpr (lahzam::reflectable<T>)
+          changed |= details::inspect_aggregate(*node, std::make_index_sequence<lahzam::member_count<T>>{},
+                                                std::addressof(details::next_link(*node)));
+        else
+          changed |= ImInspect::do_inspection(*node, label);
+      }
+      return false;
+    });
+
+    if (chain.cycle_start != std::size_t(-1))
+      ImGui::TextDisabled("[%zu] links back to [%zu]", chain.size - 1, chain.cycle_start);
+
+    for (std::size_t n = LinkedChain<T>::counted_per_frame; n != 0 && walk.step(); --n) {}
+    chain.complete = walk.end != std::size_t(-1);
+    if (chain.complete) {
+      chain.size        = walk.end;
+      chain.cycle_start = walk.cycle_start;
+    }
+    else {
+      chain.size        = std::max(chain.size, walk.index + 1);
+      chain.cycle_start = std::size_t(-1);
+    }
+    return changed;
+  }
+
+  // Hash of `size` bytes, the bulk of it runs in SIMD lanes when available.
+  std::uint64_t hash_bytes(const void* p, std::size_t size, std::uint64_t seed);
+
+  constexpr std::uint64_t hash_mix(const std::uint64_t h, const std::uint64_t v)
+  {
+    return h ^ (v + 0x9e3779b97f4a7c15 + (h << 6) + (h >> 2));
+  }
+
+  template<typename T>
+  constexpr bool hashed_as_bytes();
+
+  template<typename T, std::size_t... Is>
+  constexpr bool members_hashed_as_bytes(std::index_sequence<Is...>)
+  {
+    return (details::hashed_as_bytes<std::remove_cvref_t<decltype(lahzam::get<Is>(std::declval<T&>()))>>() && ...) &&
+           (sizeof(std::remove_cvref_t<decltype(lahzam::get<Is>(std::declval<T&>()))>) + ... + 0) == sizeof(T);
+  }
+
+  // Values without padding, so their bytes change exactly when the value does.
+  template<typename T>
+  constexpr bool hashed_as_bytes()
+  {
+    if constexpr (!std::is_trivially_copyable_v<T>)
+      return false;
+    else if constexpr (std::has_unique_object_representations_v<T>)
+      return true;
+    else if constexpr (std::is_floating_point_v<T>)
+      return !std::is_same_v<T, long double>;
+    else if constexpr (std::is_bounded_array_v<T>)
+      return details::hashed_as_bytes<std::remove_extent_t<T>>();
+    else if constexpr (lahzam::reflectable<T>)
+      return details::members_hashed_as_bytes<T>(std::make_index_sequence<lahzam::member_count<T>>{});
+    else
+      return false;
+  }
+
+  template<typename T>
+  concept PathLike = requires(const T& t) {
+    t.native();
+    t.stem();
+    t.extension();
+    requires(enchantum::raw_type_name<T>.find("std::") != std::size_t(-1));
+  };
+
+  template<typename R>
+  concept BytesRange = std::ranges::contiguous_range<R> && std::ranges::sized_range<R> &&
+                       details::hashed_as_bytes<std::ranges::range_value_t<R>>();
+
+  // Hash of what `do_inspection` shows of `t`, walked the same way. Pointees are not followed, a pointer hashes
+  // its address. Types that are neither trivially copyable nor walkable always hash to `seed`.
+  template<typename T>
+  std::uint64_t content_hash(const T& t, const std::uint64_t seed = 0)
+  {
+    if constexpr (details::hashed_as_bytes<T>()) {
+      return details::hash_bytes(std::addressof(t), sizeof(T), seed);
+    }
+    else if constexpr (PathLike<T>) {
+      const auto& s = t.native();
+      return details::hash_bytes(s.data(), s.size() * sizeof(s[0]), seed);
+    }
+    else if constexpr (BytesRange<const T>) {
+      const auto size = static_cast<std::size_t>(std::ranges::size(t));
+      return details::hash_bytes(
+        std::ranges::data(t), size * sizeof(std::ranges::range_value_t<const T>), details::hash_mix(seed, size));
+    }
+    else if constexpr (std::ranges::range<const T>) {
+      std::uint64_t h    = seed;
+      std::size_t   size = 0;
+      for (const auto& e : t) {
+        h = details::content_hash(e, h);
+        ++size;
+      }
+      return details::hash_mix(h, size);
+    }
+    else if constexpr (TupleLike<T>) {
+      return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+        using ::std::get;
+        std::uint64_t h = seed;
+        ((h = details::content_hash(get<Is>(t), h)), ...);
+        return h;
+      }(std::make_index_sequence<std::tuple_size_v<T>>{});
+    }
+    else if constexpr (VariantLike<T>) {
+      using ::std::visit;
+      if constexpr (requires { t.valueless_by_exception(); }) {
+        if (t.valueless_by_exception())
+          return details::hash_mix(seed, std::size_t(-1));
+      }
+      const auto h = details::hash_mix(seed, t.index());
+      return visit([h](const auto& e) { return details::content_hash(e, h); }, t);
+    }
+    else if constexpr (OptionalLike<T>) {
+      return t ? details::content_hash(*t, details::hash_mix(seed, 1)) : details::hash_mix(seed, 0);
+    }
+    else if constexpr (PointerLike<T>) {
+      return details::hash_mix(seed, t ? reinterpret_cast<std::uintptr_t>(std::addressof(*t)) : 0);
+    }
+    else if constexpr (lahzam::reflectable<T>) {
+      return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+        std::uint64_t h = seed;
+        ((h = details::content_hash(lahzam::get<Is>(t), h)), ...);
+        return h;
+      }(std::make_index_sequence<lahzam::member_count<T>>{});
+    }
+    else if constexpr (std::is_trivially_copyable_v<T>) {
+      return details::hash_bytes(std::addressof(t), sizeof(T), seed);
+    }
+    else {
+      return seed;
+    }
+  }
+
+  // Text of a read-only value, cached by node and by `hash` of the value. It is formatted again when the hash changed,
+  // or every time when `hashed` is false, but not more often than the rate of the node, see `set_next_refresh_rate`.
+  // The text stays valid until the end of the frame.
+  Label cached_text(
+    Label name, std::uint64_t hash, bool hashed, void (*format)(const void*, std::string&), const void* value);
+
+  template<typename T>
+  void format_value(const void* const p, std::string& out)
+  {
+    const T& v = *static_cast<const T*>(p);
+    if constexpr (requires { std::formatter<T>{}; })
+      std::format_to(std::back_inserter(out), "{}", v);
+    else
+      out = std::string_view(v.to_string());
+  }
+
+  template<typename T>
+  Label cached_text(const Label name, const T& t)
+  {
+    // content_hash falls back to the seed for values it cannot look into, those are only throttled
+    constexpr bool hashed = details::hashed_as_bytes<T>() || std::ranges::range<const T> || TupleLike<T> ||
+                            VariantLike<T> || OptionalLike<T> || PointerLike<T> || lahzam::reflectable<T> ||
+                            std::is_trivially_copyable_v<T>;
+    return details::cached_text(
+      name, hashed ? details::content_hash(t) : 0, hashed, &details::format_value<T>, std::addressof(t));
+  }
+
+  // What a node that drew nested values hashes of itself, the nested values report their own changes.
+  template<typename T>
+  std::uint64_t shallow_hash(const T& t)
+  {
+    if constexpr (std::ranges::sized_range<const T>)
+      return static_cast<std::uint64_t>(std::ranges::size(t));
+    else if constexpr (VariantLike<T>)
+      return static_cast<std::uint64_t>(t.index());
+    else if constexpr (OptionalLike<T>)
+      return t ? 1 : 0;
+    else if constexpr (PointerLike<T>)
+      return details::content_hash(t);
+    else
+      return 0;
+  }
+
+  template<typename T>
+  std::uint64_t erased_content_hash(const void* const p)
+  {
+    return details::content_hash(*static_cast<const T*>(p));
   }
 
+  // `Config::HighlightChanges`, one per inspected value. The hash of every drawn node is kept from frame to frame,
+  // entries of nodes not drawn for `Config::NodeStateLifetime` frames are dropped, so the memory follows what is
+  // visible. Each value is hashed once per frame: a node that drew nested values changed when one of them did or its
+  // `shallow_hash` differs, only nodes drawn without nested ones, such as leaves and collapsed nodes, hash their whole
+  // content. A changed node flashes its rows, only the first one when nested values were drawn.
+  class ChangeHighlight {
+  public:
+    template<typename T>
+    ChangeHighlight(const Label name, const T& t)
+      : ChangeHighlight(name, std::addressof(t), &details::erased_content_hash<T>, details::shallow_hash(t))
+    {
+    }
+    ~ChangeHighlight();
+    ChangeHighlight(const ChangeHighlight&)            = delete;
+    ChangeHighlight& operator=(const ChangeHighlight&) = delete;
+
+  private:
+    ChangeHighlight(Label name, const void* value, std::uint64_t (*hash)(const void*), std::uint64_t shallow);
+
+    ChangeHighlight* parent;
+    const void*      value;
+    std::uint64_t (*hash)(const void*);
+    std::uint64_t shallow;
+    ImGuiID       id;
+    ImVec2        top_left;
+    float         right;
+    bool          nested         = false;
+    bool          nested_changed = false;
+  };
+
 } // namespace details
 
 
 template<typename T>
 struct inspect;
 
+namespace details {
+
+  // Runs `inspect<T>`. Specializations may return whether they changed the value, for ones returning void
+  // small trivially copyable values are compared before and after, anything else is reported as unchanged.
+  template<typename T>
+  bool run_inspector(T& t, const Label name)
+  {
+    using V = std::remove_const_t<T>;
+    if constexpr (std::is_convertible_v<decltype(inspect<V>{}(t, name)), bool>) {
+      return static_cast<bool>(inspect<V>{}(t, name));
+    }
+    else if constexpr (!std::is_const_v<T> && std::is_trivially_copyable_v<T> && sizeof(T) <= 4096) {
+      unsigned char before[sizeof(T)];
+      std::memcpy(before, std::addressof(t), sizeof(T));
+      inspect<V>{}(t, name);
+      return std::memcmp(before, std::addressof(t), sizeof(T)) != 0;
+    }
+    else {
+      inspect<V>{}(t, name);
+      return false;
+    }
+  }
+
+} // namespace details
+
 template<typename T>
-void do_inspection(const T& t, const std::string& name)
+bool do_inspection(const T& t, const Label name)
 {
   static_assert(!std::is_volatile_v<T>);
+
+  const details::InspectionScope scope(name, std::addressof(t), &details::type_tag<std::remove_cv_t<T>>);
+  if (scope.too_deep()) {
+    ImGui::Text("%s: <maximum depth count reached>", name.c_str());
+    return false;
+  }
+
+  std::optional<details::ChangeHighlight> highlight;
+  if (ImInspect::GetConfig().HighlightChanges)
+    highlight.emplace(name, t);
+
   if constexpr (requires { inspect<T>{}(t, name); }) {
-    inspect<T>{}(t, name);
+    return details::run_inspector(t, name);
   }
   else if constexpr (std::is_enum_v<T>) {
     if constexpr (is_opaque_enum<T>) {
@@ -516,9 +3088,12 @@ void do_inspection(const T& t, const std::string& name)
         details::EnumListBox(name, v);
     }
   }
+  else if constexpr (details::ScalarVector<T> || details::ScalarMatrix<T>) {
+    details::print_scalar_grid(t, name);
+  }
   else if constexpr (std::ranges::range<T>) {
     if constexpr (details::AssociativeContainer<T>) {
-      details::print_asscoiative_range(std::ranges::begin(t), std::ranges::end(t), name);
+      return details::print_asscoiative_range(t, name);
     }
     else if constexpr (requires {
                          t.string();
@@ -529,129 +3104,345 @@ void do_inspection(const T& t, const std::string& name)
       ImInspect::do_inspection(std::string_view(t.string()), name);
     }
     else {
-      details::print_container(t, name);
+      return details::print_container(t, name);
     }
   }
   else if constexpr (details::TupleLike<T>) {
-    details::print_tuple(t, name, std::make_index_sequence<std::tuple_size_v<T>>{});
+    return details::print_tuple(t, name, std::make_index_sequence<std::tuple_size_v<T>>{});
   }
   else if constexpr (details::VariantLike<T>) {
-    details::print_variant(t, name, std::make_index_sequence<std::variant_size_v<T>>{});
+    return details::print_variant(t, name, std::make_index_sequence<std::variant_size_v<T>>{});
   }
   else if constexpr (details::OptionalLike<T>) {
-    details::inspect_optional(t, name);
+    return details::inspect_optional(t, name);
   }
   else if constexpr (details::PointerLike<T>) {
     if constexpr (std::is_function_v<std::remove_pointer_t<T>>) {
-      details::display_function_pointer(reinterpret_cast<void (*)()>(t), name, type_name<T>);
+      details::display_function_pointer(reinterpret_cast<void (*)()>(t), name, normalized_type_name<T>);
     }
     else {
-      details::inspect_pointer(t, name);
+      return details::inspect_pointer(t, name);
     }
   }
   else if constexpr (std::is_empty_v<T>) {
     ImGui::Text("{ this is an empty type }");
   }
   else if constexpr (requires { std::formatter<T>{}; }) {
-    ImInspect::do_inspection(std::format("{}", t), name);
+    ImInspect::do_inspection(std::string_view(details::cached_text(name, t)), name);
   }
   else if constexpr (lahzam::reflectable<T>) {
+    if constexpr (details::StructOfArrays<T>) {
+      const ImSweet::ID id(name.c_str());
+      bool              changed = false;
+      if (details::print_struct_of_arrays(t, changed, std::make_index_sequence<lahzam::member_count<T>>{}))
+        return changed;
+    }
     (void)name;
-    details::inspect_aggregate(t, std::make_index_sequence<lahzam::member_count<T>>{});
+    return details::inspect_aggregate(t, std::make_index_sequence<lahzam::member_count<T>>{});
+  }
+  else if constexpr (requires { t.to_string(); }) {
+    ImInspect::do_inspection(std::string_view(details::cached_text(name, t)), name);
   }
   else {
     static_assert(sizeof(T) == 0, "cannot format type please specialize inspect<T>.");
   }
+  return false;
 }
 
+namespace details {
+
+  template<typename T>
+  bool inspect_value(T& t, const Label name)
+  {
+    if constexpr (requires { inspect<T>{}(t, name); }) {
+      return details::run_inspector(t, name);
+    }
+    else if constexpr (std::is_enum_v<T>) {
+      if constexpr (is_opaque_enum<T>) {
+        auto       v       = static_cast<std::underlying_type_t<T>>(t);
+        const bool changed = details::modify_numeric_int(
+          static_cast<void*>(&v), name, sizeof(v), std::is_unsigned_v<decltype(v)>, normalized_type_name<T>);
+        if (changed)
+          t = T(v);
+        return changed;
+      }
+      else if constexpr (enchantum::is_bitflag<T>) {
+        return details::EnumCheckboxFlags(name.c_str(), t);
+      }
+      else {
+        return details::EnumListBox<T>(name.c_str(), t);
+      }
+    }
+    else if constexpr (!std::is_same_v<T, long double> && std::is_floating_point_v<T>) {
+      return details::modify_numeric_float(
+        static_cast<void*>(&t), name, std::is_same_v<T, double>, normalized_type_name<T>);
+    }
+    else if constexpr (std::is_integral_v<T>) {
+      return details::modify_numeric_int(
+        static_cast<void*>(&t), name, sizeof(T), std::is_unsigned_v<T>, normalized_type_name<T>);
+    }
+    else if constexpr (details::ScalarVector<T> || details::ScalarMatrix<T>) {
+      return details::print_scalar_grid(t, name);
+    }
+    else if constexpr (std::ranges::range<T>) {
+      if constexpr (details::AssociativeContainer<T>) {
+        return details::print_asscoiative_range(t, name);
+      }
+      else if constexpr (requires {
+                           t.string();
+                           t.stem();
+                           t.extension();
+                           requires(enchantum::raw_type_name<T>.find("std::") != std::size_t(-1));
+                         }) {
+        return details::inspect_filesystem_path(static_cast<void*>(&t), name);
+      }
+      else {
+        return details::print_container(t, name);
+      }
+    }
+    else if constexpr (details::TupleLike<T>) {
+      return details::print_tuple(t, name, std::make_index_sequence<std::tuple_size_v<T>>{});
+    }
+    else if constexpr (details::VariantLike<T>) {
+      return details::print_variant(t, name, std::make_index_sequence<std::variant_size_v<T>>{});
+    }
+    else if constexpr (details::OptionalLike<T>) {
+      return details::inspect_optional(t, name);
+    }
+    else if constexpr (details::PointerLike<T>) {
+      if constexpr (std::is_function_v<std::remove_pointer_t<T>>) {
+        details::display_function_pointer(reinterpret_cast<void (*)()>(t), name, normalized_type_name<T>);
+        return false;
+      }
+      else {
+        return details::inspect_pointer(t, name);
+      }
+    }
+    else if constexpr (std::is_empty_v<T>) {
+      ImGui::Text("{ this is an empty type }");
+      return false;
+    }
+    else if constexpr (lahzam::reflectable<T>) {
+      if constexpr (details::StructOfArrays<T>) {
+        const ImSweet::ID id(name.c_str());
+        bool              changed = false;
+        if (details::print_struct_of_arrays(t, changed, std::make_index_sequence<lahzam::member_count<T>>{}))
+          return changed;
+      }
+      (void)name;
+      return details::inspect_aggregate(t, std::make_index_sequence<lahzam::member_count<T>>{});
+    }
+    else {
+      static_assert(sizeof(T) == 0, "cannot inspect type please specialize inspect<T>.");
+    }
+  }
+
+  // `Config::VerifyUntouched`, the bytes of `t` are compared with a copy taken before it was drawn.
+  template<typename T>
+  bool verify_untouched(T& t, const Label name)
+  {
+    auto* const before = details::frame_memory().allocate(sizeof(T), alignof(T));
+    std::memcpy(before, std::addressof(t), sizeof(T));
+    const bool changed = details::inspect_value(t, name);
+    assert((changed || std::memcmp(before, std::addressof(t), sizeof(T)) == 0) &&
+           "do_inspection wrote to a value it reported as unchanged");
+    return changed;
+  }
+
+} // namespace details
+
 template<typename T>
-void do_inspection(T& t, const std::string& name)
+bool do_inspection(T& t, const Label name)
 {
   static_assert(!std::is_volatile_v<T>);
 
-
-  constexpr int           max_depth = 32;
-  thread_local static int depth     = 0;
-
-  if (depth >= max_depth) {
+  const details::InspectionScope scope(name, std::addressof(t), &details::type_tag<std::remove_cv_t<T>>);
+  if (scope.too_deep()) {
     ImGui::Text("%s: <maximum depth count reached>", name.c_str());
-    return;
+    return false;
   }
 
-  ++depth;
+  std::optional<details::ChangeHighlight> highlight;
+  if (ImInspect::GetConfig().HighlightChanges)
+    highlight.emplace(name, t);
 
-  if constexpr (requires { inspect<T>{}(t, name); }) {
-    inspect<T>{}(t, name);
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    if (ImInspect::GetConfig().VerifyUntouched)
+      return details::verify_untouched(t, name);
   }
-  else if constexpr (std::is_enum_v<T>) {
-    if constexpr (is_opaque_enum<T>) {
-      auto v = static_cast<std::underlying_type_t<T>>(t);
-      details::modify_numeric_int(static_cast<void*>(&v), name, sizeof(v), std::is_unsigned_v<decltype(v)>, type_name<T>);
-      t = T(v);
+  return details::inspect_value(t, name);
+}
+
+template<typename T>
+struct default_value {
+  T operator()() const { return T{}; }
+};
+
+namespace details {
+
+  // Edits of a snapshot become patches that assign the edited parts of the live value. `get` leads from the root to
+  // the part, it returns nullptr once that part is gone, such as an element of a vector that shrank meanwhile.
+  // Reflectable aggregates and arrays are compared member by member and element by element, ranges of the same
+  // size element by element, everything else is assigned as a whole when it differs.
+  template<typename Root, typename U, typename Get>
+  void diff_into_patches(const U& before, const U& after, const Get& get, std::vector<std::function<void(Root&)>>& out)
+  {
+    const auto assign = [&] {
+      using P = std::remove_pointer_t<decltype(get(std::declval<Root&>()))>;
+      if constexpr (std::is_assignable_v<P&, const U&>) {
+        out.push_back([get, value = after](Root& r) {
+          if (P* const p = get(r))
+            *p = value;
+        });
+      }
+    };
+
+    if constexpr (std::is_trivially_copyable_v<U> && !lahzam::reflectable<U> && !std::is_array_v<U> &&
+                  !TupleLike<U>) {
+      if (std::memcmp(std::addressof(before), std::addressof(after), sizeof(U)) != 0)
+        assign();
     }
-    else if constexpr (enchantum::is_bitflag<T>) {
-      details::EnumCheckboxFlags(name.c_str(), t);
+    else if constexpr (std::is_array_v<U> || (TupleLike<U> && std::ranges::random_access_range<U>)) {
+      for (std::size_t i = 0; i < std::size(before); ++i) {
+        details::diff_into_patches<Root>(before[i], after[i], [get, i](Root& r) {
+          auto* const a = get(r);
+          return a != nullptr ? std::addressof((*a)[i]) : nullptr;
+        }, out);
+      }
     }
-    else {
-      details::EnumListBox<T>(name.c_str(), t);
+    else if constexpr (lahzam::reflectable<U> && !std::ranges::range<U>) {
+      [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+        (details::diff_into_patches<Root>(lahzam::get<Is>(before), lahzam::get<Is>(after), [get](Root& r) {
+           auto* const a = get(r);
+           return a != nullptr ? std::addressof(lahzam::get<Is>(*a)) : nullptr;
+         }, out), ...);
+      }(std::make_index_sequence<lahzam::member_count<U>>{});
     }
-  }
-  else if constexpr (!std::is_same_v<T, long double> && std::is_floating_point_v<T>) {
-    details::modify_numeric_float(static_cast<void*>(&t), name, std::is_same_v<T, double>, type_name<T>);
-  }
-  else if constexpr (std::is_integral_v<T>) {
-    details::modify_numeric_int(static_cast<void*>(&t), name, sizeof(T), std::is_unsigned_v<T>, type_name<T>);
-  }
-  else if constexpr (std::ranges::range<T>) {
-    if constexpr (details::AssociativeContainer<T>) {
-      details::print_asscoiative_range(std::ranges::begin(t), std::ranges::end(t), name);
+    else if constexpr (std::ranges::random_access_range<U> && std::ranges::sized_range<U> &&
+                       !CharLike<std::ranges::range_value_t<U>> &&
+                       std::is_reference_v<std::ranges::range_reference_t<U>> && requires(U& u) { u[std::size_t()]; }) {
+      const auto size = static_cast<std::size_t>(std::ranges::size(before));
+      if (size != static_cast<std::size_t>(std::ranges::size(after))) {
+        assign();
+        return;
+      }
+      for (std::size_t i = 0; i < size; ++i) {
+        details::diff_into_patches<Root>(before[i], after[i], [get, i](Root& r) {
+          auto* const c = get(r);
+          if (c == nullptr || i >= static_cast<std::size_t>(std::ranges::size(*c)))
+            return static_cast<decltype(std::addressof((*c)[i]))>(nullptr);
+          return std::addressof((*c)[i]);
+        }, out);
+      }
     }
-    else if constexpr (requires {
-                         t.string();
-                         t.stem();
-                         t.extension();
-                         requires(enchantum::raw_type_name<T>.find("std::") != std::size_t(-1));
-                       }) {
-      details::inspect_filesystem_path(static_cast<void*>(&t), name);
+    else if constexpr (std::equality_comparable<U>) {
+      if (!(before == after))
+        assign();
     }
-    else {
-      details::print_container(t, name);
+    else if (details::content_hash(before) != details::content_hash(after)) {
+      assign();
     }
   }
-  else if constexpr (details::TupleLike<T>) {
-    details::print_tuple(t, name, std::make_index_sequence<std::tuple_size_v<T>>{});
-  }
-  else if constexpr (details::VariantLike<T>) {
-    details::print_variant(t, name, std::make_index_sequence<std::variant_size_v<T>>{});
-  }
-  else if constexpr (details::OptionalLike<T>) {
-    details::inspect_optional(t, name);
+
+} // namespace details
+
+// Inspects a value that another thread writes, without reading it while it changes.
+// The thread owning the value calls `sync()` where nothing writes it, between two jobs for example. It applies the
+// edits made in the inspector since the previous sync and copies the value for the inspector, with memcpy when it is
+// trivially copyable. The UI thread calls `inspect()`, which draws the newest copy and queues edits as patches
+// instead of writing the value. The copies go through three buffers, so neither thread ever waits for the other.
+// Construct it where nothing writes the value either, it starts with copies of it. Pointees are not copied,
+// so edits through pointers still write them directly.
+template<typename T>
+class Snapshot {
+public:
+  explicit Snapshot(T& live) : live(live), slots{Slot{live}, Slot{live}, Slot{live}}, view(live) {}
+
+  Snapshot(const Snapshot&)            = delete;
+  Snapshot& operator=(const Snapshot&) = delete;
+
+  ~Snapshot() { delete pending.exchange(nullptr); }
+
+  // Owner thread.
+  void sync()
+  {
+    if (const auto batch = std::unique_ptr<Batch>(pending.exchange(nullptr, std::memory_order_acquire))) {
+      for (const auto& patch : *batch)
+        patch.apply(live);
+      applied = batch->back().seq;
+    }
+
+    auto& slot = slots[back];
+    if constexpr (std::is_trivially_copyable_v<T>)
+      std::memcpy(static_cast<void*>(std::addressof(slot.value)), std::addressof(live), sizeof(T));
+    else
+      slot.value = live; // assigning reuses the buffers of the previous copy
+    slot.applied = applied;
+    back         = middle.exchange(back | fresh, std::memory_order_acq_rel) & ~fresh;
   }
-  else if constexpr (details::PointerLike<T>) {
-    if constexpr (std::is_function_v<std::remove_pointer_t<T>>) {
-      details::display_function_pointer(reinterpret_cast<void (*)()>(t), name, type_name<T>);
+
+  // UI thread, returns true when the user changed the value.
+  bool inspect(const Label name)
+  {
+    if (middle.load(std::memory_order_relaxed) & fresh) {
+      front      = middle.exchange(front, std::memory_order_acq_rel) & ~fresh;
+      auto& base = slots[front];
+      // edits the owner did not apply yet stay visible
+      std::erase_if(sent, [&](const Patch& p) { return p.seq <= base.applied; });
+      for (const auto& p : sent)
+        p.apply(base.value);
+      view = base.value;
     }
-    else {
-      details::inspect_pointer(t, name);
+
+    auto& base = slots[front];
+    if (!sent.empty())
+      ImGui::TextDisabled("%zu edits waiting for the next sync", sent.size());
+    if (!ImInspect::do_inspection(view, name))
+      return false;
+
+    std::vector<std::function<void(T&)>> edits;
+    details::diff_into_patches<T>(base.value, view, [](T& r) { return std::addressof(r); }, edits);
+    if (edits.empty())
+      return true;
+
+    Batch* batch = pending.exchange(nullptr, std::memory_order_acquire);
+    if (batch == nullptr)
+      batch = new Batch;
+    for (auto& e : edits) {
+      e(base.value);
+      sent.push_back({++seq, e});
+      batch->push_back({seq, std::move(e)});
     }
-  }
-  else if constexpr (std::is_empty_v<T>) {
-    ImGui::Text("{ this is an empty type }");
-  }
-  else if constexpr (lahzam::reflectable<T>) {
-    (void)name;
-    details::inspect_aggregate(t, std::make_index_sequence<lahzam::member_count<T>>{});
-  }
-  else {
-    static_assert(sizeof(T) == 0, "cannot inspect type please specialize inspect<T>.");
+    pending.store(batch, std::memory_order_release);
+    return true;
   }
 
-  --depth;
-}
+private:
+  struct Slot {
+    T             value;
+    std::uint64_t applied = 0;
+  };
 
-template<typename T>
-struct default_value {
-  T operator()() const { return T{}; }
+  struct Patch {
+    std::uint64_t             seq;
+    std::function<void(T&)> apply;
+  };
+  using Batch = std::vector<Patch>;
+
+  static constexpr unsigned fresh = 4;
+
+  T& live;
+  // the owner writes slots[back], the UI reads slots[front], `middle` holds the third one and whether it is newer
+  Slot                  slots[3];
+  std::atomic<unsigned> middle = 1;
+  unsigned              back   = 0;
+  unsigned              front  = 2;
+  std::atomic<Batch*>   pending = nullptr;
+  std::uint64_t         applied = 0;
+
+  T                  view;
+  std::vector<Patch> sent;
+  std::uint64_t      seq = 0;
 };
 
 } // namespace ImInspect
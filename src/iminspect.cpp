@@ -1,14 +1,33 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cfloat>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
 #include <cstring>
 #include <filesystem>
 #include <format>
 #include <imgui.h>
 #include <iminspect.hpp>
 #include <iomanip>
+#include <memory_resource>
+#include <mutex>
 #include <regex>
+#include <shared_mutex>
+#include <span>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
 
 namespace ImInspect {
 Style& GetStyle()
@@ -27,6 +46,12 @@ Style& GetStyle()
   return style;
 }
 
+Config& GetConfig()
+{
+  static Config config{};
+  return config;
+}
+
 namespace {
   struct RegexAlias {
     std::regex  pattern;
@@ -37,66 +62,26 @@ namespace {
     static std::unordered_set<std::string, std::hash<std::string_view>, std::equal_to<>> r;
     return r;
   }
+  // Only user aliases live here, the standard library ones are handled by `details::normalize_type_name_structurally`.
   auto& get_regex_aliases()
   {
-    static auto r = []() {
-      std::vector<RegexAlias> ret;
-      const auto              add = [&ret](const std::string_view a, std::string p) {
-        ret.push_back({std::regex(a.data(), a.data() + a.size()), std::move(p)});
-      };
-
-      // FROM CHATGPT
-      // --- String types ---
-      add(R"(std::basic_string<\s*char\s*,\s*std::char_traits<.*?>\s*,\s*std::allocator<\s*char\s*>\s*>)",
-          "std::string");
-      add(R"(std::basic_string<\s*char8_t\s*,\s*std::char_traits<.*?>\s*,\s*std::allocator<\s*char8_t\s*>\s*>)",
-          "std::u8string");
-      add(R"(std::basic_string<\s*char16_t\s*,\s*std::char_traits<.*?>\s*,\s*std::allocator<\s*char16_t\s*>\s*>)",
-          "std::u16string");
-      add(R"(std::basic_string<\s*char32_t\s*,\s*std::char_traits<.*?>\s*,\s*std::allocator<\s*char32_t\s*>\s*>)",
-          "std::u32string");
-      add(R"(std::basic_string<\s*wchar_t\s*,\s*std::char_traits<.*?>\s*,\s*std::allocator<\s*wchar_t\s*>\s*>)",
-          "std::wstring");
-
-      // --- STL containers ---
-      add(R"(std::vector<([^,>]+),\s*std::allocator<[^>]+>>)", "std::vector<$1>");
-      add(R"(std::deque<([^,>]+),\s*std::allocator<[^>]+>>)", "std::deque<$1>");
-      add(R"(std::list<([^,>]+),\s*std::allocator<[^>]+>>)", "std::list<$1>");
-      add(R"(std::set<([^,>]+),\s*std::less<[^>]+>,\s*std::allocator<[^>]+>>)", "std::set<$1>");
-      add(R"(std::unordered_set<([^,>]+),\s*std::hash<[^>]+>,\s*std::equal_to<[^>]+>,\s*std::allocator<[^>]+>>)",
-          "std::unordered_set<$1>");
-      add(R"(std::map<([^,]+),([^,>]+),\s*std::less<[^>]+>,\s*std::allocator<[^>]+>>)", "std::map<$1,$2>");
-      add(R"(std::unordered_map<([^,]+),([^,>]+),\s*std::hash<[^>]+>,\s*std::equal_to<[^>]+>,\s*std::allocator<[^>]+>>)",
-          "std::unordered_map<$1,$2>");
-      add(R"(std::pair<\s*([^,]+)\s*,\s*([^>]+)\s*>)", "std::pair<$1,$2>");
-
-      // --- Smart pointers ---
-      add(R"(std::unique_ptr<([^>]+)>)", "std::unique_ptr<$1>");
-      add(R"(std::shared_ptr<([^>]+)>)", "std::shared_ptr<$1>");
-      add(R"(std::weak_ptr<([^>]+)>)", "std::weak_ptr<$1>");
-
-      // --- String views ---
-      add(R"(std::basic_string_view<\s*char\s*,\s*std::char_traits<.*?>\s*>)", "std::string_view");
-      add(R"(std::basic_string_view<\s*char8_t\s*,\s*std::char_traits<.*?>\s*>)", "std::u8string_view");
-      add(R"(std::basic_string_view<\s*char16_t\s*,\s*std::char_traits<.*?>\s*>)", "std::u16string_view");
-      add(R"(std::basic_string_view<\s*char32_t\s*,\s*std::char_traits<.*?>\s*>)", "std::u32string_view");
-      add(R"(std::basic_string_view<\s*wchar_t\s*,\s*std::char_traits<.*?>\s*>)", "std::wstring_view");
-
-      // --- Common STL helpers ---
-      add(R"(std::span<([^>]+)>)", "std::span<$1>");
-      add(R"(std::array<([^,]+),\s*(\d+)>)", "std::array<$1,$2>");
-      add(R"(std::optional<([^>]+)>)", "std::optional<$1>");
-      add(R"(std::variant<([^>]+)>)", "std::variant<$1>");
-
-      // --- Chrono types ---
-      add(R"(std::chrono::duration<([^,]+),\s*([^>]+)>)", "std::chrono::duration<$1,$2>");
-      add(R"(std::chrono::time_point<([^,]+),\s*([^>]+)>)", "std::chrono::time_point<$1,$2>");
-
-      return ret;
-    }();
+    static std::vector<RegexAlias> r;
     return r;
   }
 
+  auto& get_type_aliases()
+  {
+    static std::vector<details::TypeNameRule> r;
+    return r;
+  }
+
+  std::string apply_regex_aliases(std::string s)
+  {
+    for (const auto& entry : get_regex_aliases())
+      s = std::regex_replace(s, entry.pattern, entry.replacement);
+    return s;
+  }
+
 
   void display_label_with_type_tooltip(const std::string_view label, const std::string_view type_name)
   {
@@ -104,40 +89,572 @@ namespace {
     if (ImGui::IsItemHovered())
       details::type_tooltip(type_name);
   }
-  ImGuiDataType_ map_int_type_to_imgui(const std::size_t size, const bool is_unsigned)
+
+
+  template<typename Void>
+  void display_readonly_data_voidptr(Void* const p, const Label name)
   {
-    static_assert(CHAR_BIT == 8, "This library requires 8 bit systems");
-    switch (size) {
-      case 1:
-        return is_unsigned ? ImGuiDataType_U8 : ImGuiDataType_S8;
-      case 2:
-        return is_unsigned ? ImGuiDataType_U16 : ImGuiDataType_S16;
-      case 4:
-        return is_unsigned ? ImGuiDataType_U32 : ImGuiDataType_S32;
-      case 8:
-        return is_unsigned ? ImGuiDataType_U64 : ImGuiDataType_S64;
+    static_assert(std::is_void_v<Void>);
+    char             buffer[32];
+    std::string_view s = "nullptr";
+    if (p) {
+      const auto end = std::format_to_n(buffer, sizeof(buffer), "0x{:016x}", reinterpret_cast<std::uintptr_t>(p)).out;
+      s              = std::string_view(buffer, static_cast<std::size_t>(end - buffer));
     }
-    return (assert(!"Invalid type passed"), ImGuiDataType_U8);
+    details::display_readonly_data(s, name, normalized_type_name<decltype(p)>);
   }
 
+  struct NodeStateEntry {
+    const void*                         type;
+    int                                 last_used_frame;
+    std::unique_ptr<details::NodeState> state;
+  };
 
-  template<typename Void>
-  void display_readonly_data_voidptr(Void* const p, const std::string& name)
+  // Bump allocator behind `details::frame_memory`. Blocks are kept across frames, when a frame needed more than one
+  // they are merged into one block on the next rewind, so once warm a frame allocates from a single block.
+  class FrameArena final : public std::pmr::memory_resource {
+  public:
+    void rewind()
+    {
+      if (blocks.size() > 1) {
+        std::size_t size = 0;
+        for (const auto& b : blocks)
+          size += b.size;
+        blocks.clear();
+        blocks.push_back({std::make_unique<std::byte[]>(size), size});
+      }
+      used = 0;
+    }
+
+  private:
+    struct Block {
+      std::unique_ptr<std::byte[]> data;
+      std::size_t                  size;
+    };
+
+    void* do_allocate(const std::size_t bytes, const std::size_t alignment) override
+    {
+      if (!blocks.empty()) {
+        const auto& b      = blocks.back();
+        const auto  offset = (used + alignment - 1) & ~(alignment - 1);
+        if (offset + bytes <= b.size) {
+          used = offset + bytes;
+          return b.data.get() + offset;
+        }
+      }
+
+      const auto size = std::max({bytes + alignment, blocks.empty() ? std::size_t(4096) : blocks.back().size * 2});
+      blocks.push_back({std::make_unique<std::byte[]>(size), size});
+      used = 0;
+      return do_allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    std::vector<Block> blocks;
+    std::size_t        used = 0;
+  };
+
+  struct PointeeKey {
+    const volatile void* address;
+    const void*          type;
+
+    bool operator==(const PointeeKey&) const = default;
+  };
+
+  struct PointeeKeyHash {
+    std::size_t operator()(const PointeeKey& k) const noexcept
+    {
+      return std::hash<const volatile void*>{}(k.address) ^ (std::hash<const void*>{}(k.type) << 1);
+    }
+  };
+
+  // Per thread state of the inspection in progress, the shown pointees are forgotten every frame.
+  // The pool keeps the memory of the map across frames.
+  struct InspectionState {
+    int                                                                                 frame = -1;
+    int                                                                                 depth = 0;
+    std::vector<Label>                                                                  path;
+    std::pmr::unsynchronized_pool_resource                                              pool;
+    std::pmr::unordered_map<PointeeKey, details::ShownPointee, PointeeKeyHash> shown{&pool};
+    // the pointee whose link was clicked, scrolled to when it is drawn in the next frame
+    PointeeKey scroll_to{};
+    int        scroll_frame = -1;
+  };
+
+  InspectionState& get_inspection_state()
   {
-    static_assert(std::is_void_v<Void>);
-    details::display_readonly_data(std::string_view(
-                                     !p ? "nullptr" : std::format("0x{:016x}", reinterpret_cast<std::uintptr_t>(p))),
-                                   name,
-                                   type_name<decltype(p)>);
+    thread_local InspectionState state;
+    const int                    frame = ImGui::GetFrameCount();
+    if (state.frame != frame) {
+      state.frame = frame;
+      state.shown.clear();
+    }
+    return state;
+  }
+
+  // ImGui::InputText for a std::pmr::string, like the std::string overload from imgui_stdlib.
+  bool input_text(const char* const label, std::pmr::string& s)
+  {
+    const auto resize = [](ImGuiInputTextCallbackData* const data) {
+      if (data->EventFlag == ImGuiInputTextFlags_CallbackResize) {
+        auto& str = *static_cast<std::pmr::string*>(data->UserData);
+        str.resize(static_cast<std::size_t>(data->BufTextLen));
+        data->Buf = str.data();
+      }
+      return 0;
+    };
+    return ImGui::InputText(label, s.data(), s.capacity() + 1, ImGuiInputTextFlags_CallbackResize, resize, &s);
+  }
+
+  // Null terminated copy of `s` in the frame memory for the buffer of a read only InputText.
+  char* readonly_copy(const std::string_view s)
+  {
+    auto* const p = static_cast<char*>(details::frame_memory().allocate(s.size() + 1, alignof(char)));
+    std::memcpy(p, s.data(), s.size());
+    p[s.size()] = '\0';
+    return p;
+  }
+
+  // Drops the entries that were not used for `Config::NodeStateLifetime` frames, at most once per frame.
+  template<typename Map>
+  void prune_unused_entries(Map& entries, int& pruned_frame)
+  {
+    const int frame = ImGui::GetFrameCount();
+    if (pruned_frame == frame)
+      return;
+
+    // the frame count goes back when a new context took the address of a destroyed one, its entries are dropped
+    pruned_frame        = frame;
+    const auto lifetime = ImInspect::GetConfig().NodeStateLifetime;
+    std::erase_if(entries, [&](const auto& e) {
+      return frame - e.second.last_used_frame > lifetime || frame < e.second.last_used_frame;
+    });
+  }
+
+  // A store of entries kept across frames, one per ImGui context since a thread may drive several of them.
+  // Stale entries are pruned on the first access of every frame.
+  template<typename Store>
+  Store& context_store()
+  {
+    thread_local std::unordered_map<const ImGuiContext*, Store> stores;
+    thread_local const ImGuiContext*                            last_context = nullptr;
+    thread_local Store*                                         last_store   = nullptr;
+
+    const ImGuiContext* const context = ImGui::GetCurrentContext();
+    if (last_store == nullptr || last_context != context) {
+      last_context = context;
+      last_store   = &stores[context];
+    }
+    prune_unused_entries(last_store->entries, last_store->frame);
+    return *last_store;
+  }
+
+  struct NodeStateStore {
+    int                                         frame = -1;
+    std::unordered_map<ImGuiID, NodeStateEntry> entries;
+  };
+
+  NodeStateStore& get_node_states() { return context_store<NodeStateStore>(); }
+
+  // Hashes of the nodes drawn with `Config::HighlightChanges`, pruned like the node states.
+  // `nested` tells whether `hash` is the shallow hash of a node that drew nested values.
+  struct ChangeEntry {
+    std::uint64_t hash;
+    int           last_used_frame;
+    double        changed_at;
+    bool          nested;
+  };
+
+  struct ChangeStore {
+    int                                      frame = -1;
+    details::ChangeHighlight*                open  = nullptr; // innermost node being drawn
+    std::unordered_map<ImGuiID, ChangeEntry> entries;
+  };
+
+  ChangeStore& get_change_store() { return context_store<ChangeStore>(); }
+
+  // Formatted text of read-only values, see `details::cached_text`.
+  struct TextEntry {
+    std::uint64_t hash;
+    int           last_used_frame;
+    double        formatted_at;
+    float         rate = -1; // from `set_next_refresh_rate`, negative uses the config
+    std::string   text;
+  };
+
+  struct TextStore {
+    int                                    frame = -1;
+    std::optional<float>                   next_rate;
+    std::unordered_map<ImGuiID, TextEntry> entries;
+  };
+
+  TextStore& get_text_store() { return context_store<TextStore>(); }
+
+  // Identifies the value being inspected across frames. A variant or an optional draws its value under the same
+  // name, the depth tells them apart.
+  ImGuiID inspected_node_id(const Label name)
+  {
+    const auto depth = static_cast<ImGuiID>(ImInspect::get_inspection_state().depth);
+    return ImGui::GetID(name.c_str()) ^ (depth * 0x9e3779b9u);
+  }
+
+  constexpr std::uint64_t hash_key0 = 0x9e3779b97f4a7c15;
+  constexpr std::uint64_t hash_key1 = 0xc2b2ae3d27d4eb4f;
+  constexpr std::uint64_t hash_step = 0x165667b19e3779f9;
+
+  // One 16 byte stripe, the accumulate step of XXH3 with a key that moves on every stripe so reordered stripes
+  // hash differently. The SIMD loops in `hash_bytes` compute the same sums.
+  void hash_stripe(std::uint64_t (&acc)[2],
+                   const unsigned char* const p,
+                   const std::uint64_t        k0,
+                   const std::uint64_t        k1)
+  {
+    std::uint64_t d[2];
+    std::memcpy(d, p, sizeof(d));
+    const std::uint64_t x0 = d[0] ^ k0, x1 = d[1] ^ k1;
+    acc[0] += d[1] + (x0 & 0xffffffff) * (x0 >> 32);
+    acc[1] += d[0] + (x1 & 0xffffffff) * (x1 >> 32);
+  }
+
+  constexpr std::uint64_t fmix64(std::uint64_t h)
+  {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccd;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53;
+    h ^= h >> 33;
+    return h;
+  }
+
+  struct HexView : details::NodeState {
+    std::size_t                selected = std::size_t(-1);
+    std::size_t                match    = std::size_t(-1);
+    std::string                query;
+    std::vector<unsigned char> pattern;
+    const char*                status     = nullptr; // why the last search found nothing
+    bool                       text_query = false;
+  };
+
+  // Bytes of "de ad BE EF" or "deadbeef", returns false on anything but hex digits and spaces or an odd digit count.
+  bool parse_hex_pattern(const std::string_view text, std::vector<unsigned char>& out)
+  {
+    out.clear();
+    int high = -1;
+    for (const char c : text) {
+      if (c == ' ')
+        continue;
+
+      int v = 0;
+      if (const auto r = std::from_chars(&c, &c + 1, v, 16); r.ec != std::errc())
+        return false;
+      if (high < 0) {
+        high = v;
+      }
+      else {
+        out.push_back(static_cast<unsigned char>(high * 16 + v));
+        high = -1;
+      }
+    }
+    return high < 0;
+  }
+
+  // First occurrence of `pattern` starting at or after `from`, wrapping around to the beginning.
+  // memchr (vectorized by every libc) skips to the candidates for the first byte, memcmp checks the rest.
+  std::size_t find_bytes(const std::span<const unsigned char> data,
+                         const std::span<const unsigned char> pattern,
+                         const std::size_t                    from)
+  {
+    if (pattern.empty() || pattern.size() > data.size())
+      return std::size_t(-1);
+
+    const auto search = [&](const std::size_t first, const std::size_t last) -> std::size_t {
+      const unsigned char*       p   = data.data() + first;
+      const unsigned char* const end = data.data() + last;
+      while (p < end) {
+        p = static_cast<const unsigned char*>(std::memchr(p, pattern[0], static_cast<std::size_t>(end - p)));
+        if (p == nullptr)
+          break;
+        if (std::memcmp(p + 1, pattern.data() + 1, pattern.size() - 1) == 0)
+          return static_cast<std::size_t>(p - data.data());
+        ++p;
+      }
+      return std::size_t(-1);
+    };
+
+    // starts of the matches lie in [0, starts)
+    const auto starts = data.size() - pattern.size() + 1;
+    const auto at     = std::min(from, starts);
+    if (const auto i = search(at, starts); i != std::size_t(-1))
+      return i;
+    return search(0, at);
+  }
+
+  // `writable` is null for read only bytes. Returns true when the selected byte was edited.
+  bool hex_view(const std::span<const unsigned char> bytes, unsigned char* const writable)
+  {
+    constexpr std::size_t columns    = 16;
+    constexpr int         hex_column = 10; // after "00000000: "
+    constexpr int         text_column = hex_column + columns * 3 + 2;
+
+    auto& view = details::node_state<HexView>(ImGui::GetID("##hex"));
+    if (view.selected >= bytes.size())
+      view.selected = std::size_t(-1);
+
+    // search
+    std::size_t scroll_to = std::size_t(-1);
+    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 16);
+    bool find = ImGui::InputTextWithHint(
+      "##find", view.text_query ? "text" : "hex bytes", &view.query, ImGuiInputTextFlags_EnterReturnsTrue);
+    ImGui::SameLine();
+    find |= ImGui::Button("Find Next");
+    ImGui::SameLine();
+    ImGui::Checkbox("Text", &view.text_query);
+
+    if (find) {
+      bool valid = true;
+      if (view.text_query)
+        view.pattern.assign(view.query.begin(), view.query.end());
+      else
+        valid = parse_hex_pattern(view.query, view.pattern);
+
+      const auto from = view.match == std::size_t(-1) ? 0 : view.match + 1;
+      view.match      = valid ? find_bytes(bytes, view.pattern, from) : std::size_t(-1);
+      view.status     = !valid ? "not hex bytes" : view.match == std::size_t(-1) ? "not found" : nullptr;
+      if (view.match != std::size_t(-1)) {
+        view.selected = view.match;
+        scroll_to     = view.match / columns;
+      }
+    }
+    if (view.status != nullptr) {
+      ImGui::SameLine();
+      ImGui::TextDisabled("%s", view.status);
+    }
+
+    // the selected byte
+    bool changed = false;
+    if (view.selected != std::size_t(-1)) {
+      ImGui::AlignTextToFramePadding();
+      ImGui::Text("0x%08zX", view.selected);
+      ImGui::SameLine();
+      ImGui::SetNextItemWidth(ImGui::GetFontSize() * 3);
+      if (writable != nullptr) {
+        changed = ImGui::InputScalar("##byte",
+                                     ImGuiDataType_U8,
+                                     writable + view.selected,
+                                     nullptr,
+                                     nullptr,
+                                     "%02X",
+                                     ImGuiInputTextFlags_CharsHexadecimal);
+      }
+      else {
+        ImGui::Text("%02X", bytes[view.selected]);
+      }
+    }
+
+    const float char_width = ImGui::CalcTextSize("0").x;
+    const ImU32 highlight  = ImGui::GetColorU32(ImGuiCol_TextSelectedBg);
+    const auto  rows       = (bytes.size() + columns - 1) / columns;
+    details::for_each_visible_row(
+      rows,
+      [&](const std::size_t row) {
+        const auto first = row * columns;
+        const auto count = std::min(columns, bytes.size() - first);
+
+        char line[text_column + columns + 1];
+        std::memset(line, ' ', sizeof(line));
+        std::snprintf(line, sizeof(line), "%08zX:", first);
+        line[9] = ' ';
+        for (std::size_t i = 0; i < count; ++i) {
+          static constexpr char digits[] = "0123456789ABCDEF";
+          const unsigned char   b        = bytes[first + i];
+          const auto            at       = hex_column + i * 3 + (i >= columns / 2);
+          line[at]                       = digits[b >> 4];
+          line[at + 1]                   = digits[b & 15];
+          line[text_column + i]          = b >= 0x20 && b < 0x7f ? static_cast<char>(b) : '.';
+        }
+        line[text_column + count] = '\0';
+
+        // the selection and the match under the text
+        ImGui::AlignTextToFramePadding();
+        const ImVec2 origin  = ImGui::GetCursorScreenPos();
+        const float  height  = ImGui::GetTextLineHeight();
+        auto* const  list    = ImGui::GetWindowDrawList();
+        const auto   mark    = [&](const std::size_t i) {
+          const float hex  = origin.x + char_width * static_cast<float>(hex_column + i * 3 + (i >= columns / 2));
+          const float text = origin.x + char_width * static_cast<float>(text_column + i);
+          const float y    = origin.y + ImGui::GetStyle().FramePadding.y;
+          list->AddRectFilled(ImVec2(hex, y), ImVec2(hex + char_width * 2, y + height), highlight);
+          list->AddRectFilled(ImVec2(text, y), ImVec2(text + char_width, y + height), highlight);
+        };
+        for (std::size_t i = 0; i < count; ++i) {
+          const auto offset = first + i;
+          if (offset == view.selected ||
+              (view.match != std::size_t(-1) && offset >= view.match && offset < view.match + view.pattern.size()))
+            mark(i);
+        }
+
+        ImGui::TextUnformatted(line);
+        if (ImGui::IsItemClicked()) {
+          const int column = static_cast<int>((ImGui::GetMousePos().x - ImGui::GetItemRectMin().x) / char_width);
+          int       i      = -1;
+          if (column >= hex_column && column < text_column - 2) {
+            const int c = column - hex_column - (column >= hex_column + static_cast<int>(columns / 2) * 3 ? 1 : 0);
+            i           = c / 3;
+          }
+          else if (column >= text_column) {
+            i = column - text_column;
+          }
+          if (i >= 0 && static_cast<std::size_t>(i) < count)
+            view.selected = first + static_cast<std::size_t>(i);
+        }
+        return false;
+      },
+      scroll_to);
+    return changed;
   }
 
-  void replace_all(std::string& s, const std::string_view pattern, const std::string_view with)
+
+  // Rows of a large string for the paged viewer. A row is a line, or a piece of `wrap` bytes of a longer line,
+  // so a megabyte of minified JSON is paged like any other text.
+  struct LargeString : details::NodeState {
+    static constexpr std::size_t wrap = 256;
+
+    const void*              data  = nullptr;
+    std::size_t              size  = 0;
+    bool                     stale = true;
+    bool                     open  = false;
+    std::vector<std::size_t> starts; // offset of every row
+    std::size_t              editing = std::size_t(-1);
+    std::string              line; // text of the row being edited
+
+    // Indexes the rows from row `first` on, the rows before it are kept.
+    void index(const std::string_view s, const std::size_t first)
+    {
+      data  = s.data();
+      size  = s.size();
+      stale = false;
+      starts.resize(first + 1);
+      for (std::size_t pos = starts.back(); pos < s.size();) {
+        const auto  limit = std::min(s.size(), pos + wrap);
+        const void* nl    = std::memchr(s.data() + pos, '\n', limit - pos);
+        pos               = nl ? static_cast<std::size_t>(static_cast<const char*>(nl) - s.data()) + 1 : limit;
+        if (pos < s.size() || nl)
+          starts.push_back(pos);
+      }
+    }
+
+    // Row i without its line break.
+    std::string_view row(const std::string_view s, const std::size_t i) const
+    {
+      const auto first = starts[i];
+      auto       last  = i + 1 < starts.size() ? starts[i + 1] : s.size();
+      if (last > first && s[last - 1] == '\n')
+        --last;
+      return s.substr(first, last - first);
+    }
+
+    // The index was built for other text when a row holds a line break or stops short of one.
+    bool valid_row(const std::string_view s, const std::size_t i) const
+    {
+      const auto first = starts[i];
+      const auto last  = i + 1 < starts.size() ? starts[i + 1] : s.size();
+      if (last > s.size() || first > last)
+        return false;
+
+      const auto text = s.substr(first, last - first);
+      const auto nl   = text.find('\n');
+      if (nl != std::string_view::npos)
+        return nl + 1 == text.size();
+      return last == s.size() || text.size() == wrap;
+    }
+  };
+
+  // Inline preview of a string over `Config::LargeStringThreshold` bytes with a button that opens the paged viewer
+  // below it. Only the visible rows are laid out. When `writable` is given, a double click edits a row.
+  // Returns true when `*writable` was changed.
+  bool large_string(const std::string_view       s,
+                    std::string* const           writable,
+                    const Label                  name,
+                    const std::string_view       type_name)
   {
-    std::size_t pos;
-    while ((pos = s.find(pattern)) != std::string::npos) {
-      s.erase(pos, pattern.size());
-      s.insert(pos, with);
+    const ImSweet::ID id(name.c_str());
+    auto&             view = details::node_state<LargeString>(ImGui::GetID("##large"));
+
+    {
+      // only the prefix is searched, a long single line blob is not scanned on every frame
+      const auto head       = s.substr(0, 64);
+      const auto first_line = head.substr(0, head.find('\n'));
+      const auto preview    = details::frame_format("{}... ({} bytes)", first_line, s.size());
+      const ImSweet::StyleColor color{{ImGuiCol_FrameBg, ImVec4(0.25f, 0.25f, 0.28f, 1.0f)},
+                                      {ImGuiCol_Text, ImVec4(0.9f, 0.9f, 0.9f, 1.0f)}};
+      ImGui::InputText("", readonly_copy(preview), preview.size() + 1, ImGuiInputTextFlags_ReadOnly);
     }
+    ImGui::SameLine();
+    if (ImGui::SmallButton(view.open ? "Close" : "Open"))
+      view.open = !view.open;
+    ImGui::SameLine();
+    ImInspect::display_label_with_type_tooltip(name, type_name);
+
+    if (!view.open)
+      return false;
+
+    if (view.stale || view.data != s.data() || view.size > s.size()) {
+      view.index(s, 0);
+      view.editing = std::size_t(-1);
+    }
+    else if (view.size != s.size()) {
+      // text appended in place, such as a log, only the last row and the new text are indexed
+      view.index(s, view.starts.size() - 1);
+    }
+    ImGui::TextDisabled("%zu rows", view.starts.size());
+
+    bool       changed = false;
+    const auto rows    = static_cast<float>(std::max(ImInspect::GetConfig().ClipVisibleRows, 1));
+    const auto child   = ImSweet::Child("##rows",
+                                      ImVec2(0, rows * ImGui::GetTextLineHeightWithSpacing()),
+                                      ImGuiChildFlags_Border,
+                                      ImGuiWindowFlags_HorizontalScrollbar);
+    if (!child)
+      return false;
+
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(view.starts.size()));
+    while (clipper.Step()) {
+      for (int r = clipper.DisplayStart; r < clipper.DisplayEnd; ++r) {
+        const auto i = static_cast<std::size_t>(r);
+        if (!view.valid_row(s, i)) {
+          view.stale = true;
+          break;
+        }
+
+        const auto row = view.row(s, i);
+        if (i == view.editing && writable != nullptr) {
+          const ImSweet::ID row_id(r);
+          ImGui::SetNextItemWidth(-FLT_MIN);
+          const bool entered = ImGui::InputText("##row", &view.line, ImGuiInputTextFlags_EnterReturnsTrue);
+          if (entered || ImGui::IsItemDeactivatedAfterEdit()) {
+            writable->replace(view.starts[i], row.size(), view.line);
+            view.editing = std::size_t(-1);
+            view.stale   = true;
+            changed      = true;
+            break;
+          }
+        }
+        else {
+          ImGui::TextUnformatted(row.data(), row.data() + row.size());
+          if (writable != nullptr && ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked(0)) {
+            view.editing = i;
+            view.line.assign(row);
+          }
+        }
+      }
+      if (view.stale)
+        break;
+    }
+    return changed;
   }
 
 } // namespace
@@ -146,58 +663,261 @@ struct string_hasher : std::hash<std::string_view> {
   using is_transparent = void;
 };
 
-std::string normalize_type_name(std::string_view type_name)
-{
-  static std::unordered_map<std::string, std::string, string_hasher, std::equal_to<>> cache;
+namespace {
+  auto& get_alias_mutex()
+  {
+    static std::shared_mutex r;
+    return r;
+  }
 
-  // TODO: see thread safety later
-  if (const auto it = cache.find(type_name); it != cache.end())
-    return it->second;
+  std::atomic<bool> has_user_aliases = false;
+
+  // Interns the display form of type names so lookups hand out views without allocating.
+  //
+  // Names are spread over shards by hash, each behind a shared mutex so concurrent hits only take a shared lock.
+  // In front of that sits a small direct mapped cache per thread keyed on the data pointer of the name,
+  // most names are `normalized_type_name<T>` literals so repeated lookups skip hashing and locking entirely.
+  //
+  // A shard keeps two generations bounded by `Config::TypeNameCacheBytes`. Once the current generation is full,
+  // the previous one is retired and hits in the previous generation are copied to the current one. Adding an alias
+  // retires both. The text of a retired generation is freed once every thread that looked up names since started a
+  // new ImGui frame, so a view stays valid until the end of the frame it was returned in. A thread that stops drawing
+  // holds back that memory until it draws again or exits.
+  class NameCache {
+  public:
+    using Compute = std::string (*)(std::string_view);
+
+    explicit NameCache(const Compute compute) : compute(compute) {}
+
+    std::string_view get(const std::string_view name)
+    {
+      enter_frame();
 
-  std::string s(type_name);
+      auto& slot = slots[(reinterpret_cast<std::uintptr_t>(name.data()) >> 3 ^ name.size()) % std::size(slots)];
+      // an unchanged epoch means no generation was retired since the slot was filled
+      if (slot.owner == this && slot.epoch == epoch.load() && slot.name.data() == name.data() && slot.name == name)
+        return slot.value;
 
-  static constexpr std::string_view keywords[] =
-    {"class ", "enum ", "struct ", "union ", "__1::", "__2::", "__3::", "__4::"};
+      const auto current_epoch = epoch.load();
+      const auto [key, value]  = find_or_insert(name);
+      slot                     = {this, current_epoch, key, value};
+      return value;
+    }
 
-  for (const auto& kw : keywords)
-    ImInspect::replace_all(s, kw, "");
+    // Retires every entry so names are normalized again.
+    void clear()
+    {
+      for (auto& shard : shards) {
+        const std::unique_lock lock(shard.mutex);
+        retire(shard.current);
+        retire(shard.previous);
+      }
+    }
 
-  ImInspect::replace_all(s, "volatile const ", "volatile_const@VOLATILE_CONST@");
-  ImInspect::replace_all(s, "const ", "const@CONST@");
-  ImInspect::replace_all(s, "volatile ", "volatile@VOLATILE@");
+  private:
+    using Map  = std::unordered_map<std::string_view, std::string_view, string_hasher, std::equal_to<>>;
+    using Text = std::pmr::monotonic_buffer_resource;
+
+    struct Generation {
+      Map                   entries;
+      std::unique_ptr<Text> text;
+      std::size_t           bytes = 0;
+    };
+
+    struct Shard {
+      std::shared_mutex mutex;
+      Generation        current;
+      Generation        previous;
+    };
+
+    struct Slot {
+      const NameCache* owner = nullptr;
+      std::uint64_t    epoch = 0;
+      std::string_view name;
+      std::string_view value;
+    };
+
+    struct Retired {
+      std::uint64_t         retired_at;
+      std::unique_ptr<Text> text;
+    };
+
+    // Every thread that looked up names, with the `clock` as of the start of its current frame.
+    struct Readers {
+      std::mutex                                     mutex;
+      std::vector<const std::atomic<std::uint64_t>*> frame_started_at;
+    };
+
+    struct Reader {
+      std::atomic<std::uint64_t> frame_started_at = clock.load();
+      int                        frame            = -1;
+
+      Reader()
+      {
+        auto&                  r = readers();
+        const std::scoped_lock lock(r.mutex);
+        r.frame_started_at.push_back(&frame_started_at);
+      }
 
-  std::erase_if(s, [](const auto c) { return c == ' ' || c == '\t'; });
+      ~Reader()
+      {
+        auto&                  r = readers();
+        const std::scoped_lock lock(r.mutex);
+        std::erase(r.frame_started_at, &frame_started_at);
+      }
+    };
 
-  ImInspect::replace_all(s, "const@CONST@", "const ");
-  ImInspect::replace_all(s, "volatile@VOLATILE@", "volatile ");
-  ImInspect::replace_all(s, "volatile_const@VOLATILE_CONST@", "const volatile ");
+    static constexpr std::size_t entry_overhead = 64;
 
-  for (const auto& entry : get_regex_aliases())
-    s = std::regex_replace(s, entry.pattern, entry.replacement);
+    static Readers& readers()
+    {
+      static Readers r;
+      return r;
+    }
 
-  cache.emplace(type_name, s);
+    // The thread holds no view returned in its earlier frames once it starts a new one.
+    void enter_frame()
+    {
+      if (ImGui::GetCurrentContext() == nullptr)
+        return;
+
+      const int frame = ImGui::GetFrameCount();
+      if (reader.frame == frame)
+        return;
+      reader.frame = frame;
+      reader.frame_started_at.store(clock.load());
+      if (retired_count.load() != 0)
+        collect();
+    }
 
-  return s;
-}
+    // Frees the generations retired before every reader started its current frame.
+    void collect()
+    {
+      const std::scoped_lock lock(retired_mutex);
+      auto                   oldest = clock.load();
+      {
+        auto&                  r = readers();
+        const std::scoped_lock readers_lock(r.mutex);
+        for (const auto* const started_at : r.frame_started_at)
+          oldest = std::min(oldest, started_at->load());
+      }
+      std::erase_if(retired, [oldest](const Retired& g) { return g.retired_at <= oldest; });
+      retired_count.store(retired.size());
+    }
 
-void colored_pretty_typename(const std::string& pretty, float indent)
-{
-  using namespace ImSweet;
+    // The epoch moves before the clock, a reader that still sees the old epoch started its frame before `retired_at`.
+    void retire(Generation& g)
+    {
+      epoch.fetch_add(1);
+      if (g.text != nullptr) {
+        const std::scoped_lock lock(retired_mutex);
+        retired.push_back({clock.fetch_add(1) + 1, static_cast<std::unique_ptr<Text>&&>(g.text)});
+        retired_count.store(retired.size());
+      }
+      g = {};
+    }
 
-  std::vector<std::pair<std::string_view, ImVec4>> colors;
+    static std::string_view intern(Generation& g, const std::string_view s)
+    {
+      if (g.text == nullptr)
+        g.text = std::make_unique<Text>();
+      auto* const p = static_cast<char*>(g.text->allocate(std::max(s.size(), std::size_t(1)), alignof(char)));
+      std::memcpy(p, s.data(), s.size());
+      return {p, s.size()};
+    }
 
-  const auto& style = ImInspect::GetStyle();
+    Map::value_type find_or_insert(const std::string_view name)
+    {
+      auto& shard = shards[string_hasher{}(name) % std::size(shards)];
+      {
+        const std::shared_lock lock(shard.mutex);
+        if (const auto it = shard.current.entries.find(name); it != shard.current.entries.end())
+          return *it;
+      }
 
-  const auto color_text      = style.TypeHighlighter.Text;
-  const auto color_bracket   = style.TypeHighlighter.Bracket;
-  const auto color_symbol    = style.TypeHighlighter.Symbol;
-  const auto color_operator  = style.TypeHighlighter.Operator;
-  const auto color_keyword   = style.TypeHighlighter.Keyword;
-  const auto color_namespace = style.TypeHighlighter.Namespace;
-  const auto color_name      = style.TypeHighlighter.Name;
+      const std::unique_lock lock(shard.mutex);
+      if (const auto it = shard.current.entries.find(name); it != shard.current.entries.end())
+        return *it;
+
+      // the text of the previous generation stays alive until this thread starts its next frame
+      if (const auto it = shard.previous.entries.find(name); it != shard.previous.entries.end()) {
+        const auto [key, value] = *it;
+        shard.previous.entries.erase(it);
+        return insert(shard, key, value);
+      }
 
+      const auto computed = compute(name);
+      return insert(shard, name, computed);
+    }
+
+    Map::value_type insert(Shard& shard, const std::string_view name, const std::string_view value)
+    {
+      const auto bytes  = name.size() + (value == name ? 0 : value.size()) + entry_overhead;
+      const auto budget = ImInspect::GetConfig().TypeNameCacheBytes / std::size(shards) / 2;
+      if (shard.current.bytes + bytes > budget && !shard.current.entries.empty()) {
+        retire(shard.previous);
+        shard.previous = static_cast<Generation&&>(shard.current);
+        shard.current  = {};
+      }
+
+      auto&      g   = shard.current;
+      const auto key = intern(g, name);
+      // most names are already in their display form
+      const auto interned = value == name ? key : intern(g, value);
+      g.bytes += bytes;
+      return *g.entries.emplace(key, interned).first;
+    }
+
+    Compute                    compute;
+    Shard                      shards[16];
+    std::atomic<std::uint64_t> epoch = 0;
+    std::mutex                 retired_mutex;
+    std::vector<Retired>       retired;
+    std::atomic<std::size_t>   retired_count = 0;
+
+    // counts retired generations
+    static std::atomic<std::uint64_t> clock;
+    static thread_local Slot          slots[64];
+    static thread_local Reader        reader;
+  };
+
+  std::atomic<std::uint64_t>     NameCache::clock = 0;
+  thread_local NameCache::Slot   NameCache::slots[64];
+  thread_local NameCache::Reader NameCache::reader;
+
+  std::string normalize_with_user_aliases(const std::string_view name)
+  {
+    const std::shared_lock lock(get_alias_mutex());
+    return ImInspect::apply_regex_aliases(details::normalize_type_name_structurally(name, get_type_aliases()));
+  }
+
+  auto& get_normalized_names()
+  {
+    static NameCache r(normalize_with_user_aliases);
+    return r;
+  }
+} // namespace
+
+void set_next_refresh_rate(const float rate) { get_text_store().next_rate = rate; }
+
+std::string_view normalize_type_name(const std::string_view type_name)
+{
+  return get_normalized_names().get(type_name);
+}
+
+namespace details {
+  std::string_view with_user_aliases(const std::string_view normalized)
+  {
+    if (!has_user_aliases.load(std::memory_order_acquire))
+      return normalized;
+    // normalization is idempotent, so the user aliases can share the cache of raw names
+    return get_normalized_names().get(normalized);
+  }
+} // namespace details
+
+namespace {
   // clang-format off
-static constexpr std::string_view cpp_keywords[] = {
+  constexpr std::string_view cpp_keywords[] = {
     // fundamental types
     "bool", "char", "char8_t", "char16_t", "char32_t", "wchar_t",
     "short", "int", "long", "float", "double", "void", "auto",
@@ -250,234 +970,518 @@ static constexpr std::string_view cpp_keywords[] = {
     // rarely-used compiler intrinsics
     "__asm", "__inline", "__volatile", "__cdecl", "__stdcall", "__fastcall", "__vectorcall", "__fastcall",
     "__restrict__", "__thread_local", "__alignof__", "__alignas__", "__typeof__", "__label__", "__signed__", "__unsigned__"
-};
+  };
   // clang-format on
 
-  static constexpr char brackets[]  = {'<', '>', '{', '}', '(', ')', '[', ']'};
-  static constexpr char operators[] = {',', '*', '&', '+', '-', '/', '%', '=', '!', '~', '^', '|', '?', '.'};
-  auto                  is_keyword  = [&](std::string_view token) {
-    for (auto kw : cpp_keywords)
-      if (kw == token)
-        return true;
-    return false;
+  constexpr std::uint32_t keyword_hash(const std::string_view s, const std::uint32_t seed)
+  {
+    std::uint32_t h = seed;
+    for (const char c : s)
+      h = (h ^ static_cast<unsigned char>(c)) * 16777619u;
+    return h ^ (h >> 15);
+  }
+
+  // Perfect hash of `cpp_keywords`, the seed is searched at compile time so that every keyword gets its own slot,
+  // a token is a keyword when the keyword stored in its slot is equal to it.
+  struct KeywordTable {
+    static constexpr std::size_t size = 4096;
+
+    std::uint32_t seed = 0;
+    std::uint8_t  slots[size]{}; // index into cpp_keywords + 1, 0 for an empty slot
+
+    constexpr KeywordTable()
+    {
+      static_assert(std::size(cpp_keywords) < 255);
+      for (seed = 2166136261u;; ++seed)
+        if (try_fill())
+          return;
+    }
+
+    constexpr bool try_fill()
+    {
+      for (auto& slot : slots)
+        slot = 0;
+
+      for (std::size_t i = 0; i < std::size(cpp_keywords); ++i) {
+        auto& slot = slots[keyword_hash(cpp_keywords[i], seed) % size];
+        // the list has a few duplicates which may share their slot
+        if (slot != 0 && cpp_keywords[slot - 1] != cpp_keywords[i])
+          return false;
+        slot = static_cast<std::uint8_t>(i + 1);
+      }
+      return true;
+    }
+
+    constexpr bool contains(const std::string_view token) const
+    {
+      const auto slot = slots[keyword_hash(token, seed) % size];
+      return slot != 0 && cpp_keywords[slot - 1] == token;
+    }
   };
 
-  const char*       begin = pretty.data();
-  const char* const end   = begin + pretty.size();
+  constexpr KeywordTable keyword_table;
+
+  static_assert(keyword_table.contains("const") && keyword_table.contains("__unsigned__"));
+  static_assert(!keyword_table.contains("vector") && !keyword_table.contains(""));
 
-  const auto contains = [](const auto& c, const auto& value) {
-    return std::ranges::find(c, value) != std::ranges::end(c);
+  enum class TypeNameColor : std::uint8_t { Text, Bracket, Symbol, Operator, Keyword, Namespace, Name };
+
+  struct ColoredSpan {
+    std::uint32_t begin;
+    std::uint32_t end;
+    std::uint32_t line;
+    TypeNameColor color;
+    float         x = 0; // offset from the start of the line, depends on the font
   };
 
-  const char* token_start = nullptr;
-  std::string token;
+  // Tokens of a type name with their colors, adjacent tokens of the same color are merged
+  // so drawing costs one `AddText` per color change.
+  struct ColoredTypeName {
+    std::string              text;
+    std::vector<ColoredSpan> spans;
+    std::uint32_t            lines = 1;
 
-  for (const char* it = begin; it != end; ++it) {
-    const char c = *it;
+    const ImFont*      font      = nullptr;
+    float              font_size = 0;
+    std::vector<float> line_widths;
 
-    if (std::isalnum(static_cast<unsigned char>(c)) || c == '_') {
-      if (token.empty())
-        token_start = it;
-      token += c;
-    }
-    else {
-      if (!token.empty()) {
-        ImVec4 col;
-        if (is_keyword(token))
-          col = color_keyword;
-        else
-          col = color_name;
+    int last_used_frame = 0;
+  };
 
-        colors.emplace_back(std::string_view(token_start, token.size()), col);
-        token.clear();
+  ColoredTypeName tokenize_colored_type_name(const std::string_view pretty)
+  {
+    static constexpr char brackets[]  = {'<', '>', '{', '}', '(', ')', '[', ']'};
+    static constexpr char operators[] = {',', '*', '&', '+', '-', '/', '%', '=', '!', '~', '^', '|', '?', '.'};
+
+    const auto contains = [](const auto& c, const auto& value) {
+      return std::ranges::find(c, value) != std::ranges::end(c);
+    };
+
+    ColoredTypeName r;
+    r.text = pretty;
+
+    std::uint32_t line = 0;
+    const auto    push = [&](std::size_t begin, std::size_t end, TypeNameColor color) {
+      if (!r.spans.empty() && r.spans.back().color == color && r.spans.back().end == begin &&
+          r.spans.back().line == line)
+        r.spans.back().end = static_cast<std::uint32_t>(end);
+      else
+        r.spans.push_back({static_cast<std::uint32_t>(begin), static_cast<std::uint32_t>(end), line, color});
+    };
+
+    for (std::size_t i = 0; i < pretty.size();) {
+      const char c = pretty[i];
+
+      if (details::is_identifier_char(c)) {
+        auto j = i;
+        while (j < pretty.size() && details::is_identifier_char(pretty[j]))
+          ++j;
+
+        // an identifier followed by :: names a namespace (or an enclosing class)
+        auto color = keyword_table.contains(pretty.substr(i, j - i)) ? TypeNameColor::Keyword : TypeNameColor::Name;
+        if (pretty.substr(j, 2) == "::")
+          color = TypeNameColor::Namespace;
+        push(i, j, color);
+        i = j;
       }
-
-      // handle namespace ::
-      if (c == ':' && (it + 1 != end && it[1] == ':')) {
-        if (!colors.empty())
-          colors.back().second = color_namespace;
-        colors.emplace_back(std::string_view(it, 2), color_symbol);
-        ++it;
+      else if (c == ':' && pretty.substr(i, 2) == "::") {
+        push(i, i + 2, TypeNameColor::Symbol);
+        i += 2;
+      }
+      else if (c == '\n') {
+        ++line;
+        ++i;
       }
       else {
-        ImVec4 col = color_symbol;
-
+        auto color = TypeNameColor::Symbol;
         if (contains(brackets, c))
-          col = color_bracket;
+          color = TypeNameColor::Bracket;
         else if (contains(operators, c))
-          col = color_operator;
+          color = TypeNameColor::Operator;
         else if (std::isspace(static_cast<unsigned char>(c)))
-          col = color_text;
-
-        colors.emplace_back(std::string_view(it, 1), col);
+          color = TypeNameColor::Text;
+        push(i, i + 1, color);
+        ++i;
       }
-
-      token_start = it + 1;
     }
+
+    r.lines = line + 1;
+    return r;
   }
 
-  // push remaining token
-  if (!token.empty()) {
-    colors.emplace_back(std::string_view(token_start, token.size()), is_keyword(token) ? color_keyword : color_name);
+  // Measures the spans with the current font, done again only when the font changes.
+  void layout_colored_type_name(ColoredTypeName& name)
+  {
+    const auto font      = ImGui::GetFont();
+    const auto font_size = ImGui::GetFontSize();
+    if (name.font == font && name.font_size == font_size && !name.line_widths.empty())
+      return;
+
+    name.font      = font;
+    name.font_size = font_size;
+    name.line_widths.assign(name.lines, 0.0f);
+
+    const char* text = name.text.data();
+    for (auto& span : name.spans) {
+      auto& x = name.line_widths[span.line];
+      span.x  = x;
+      x += ImGui::CalcTextSize(text + span.begin, text + span.end).x;
+    }
   }
 
-  // render all accumulated tokens
-  for (size_t i = 0; i < colors.size(); ++i) {
-    const auto& [sub, color] = colors[i];
-    auto style               = StyleColor(ImGuiCol_Text, color);
+  // Same lifetime rules as the node states, names that were not drawn for a while are dropped.
+  auto& get_colored_type_names()
+  {
+    struct Store {
+      int                                                                              frame = -1;
+      std::unordered_map<std::string, ColoredTypeName, string_hasher, std::equal_to<>> entries;
+    };
 
-    assert(sub.size() > 0);
-    if (sub[0] == '\n') {
-      auto i = ImSweet::Indent(indent);
-      details::Text("\n");
-    }
-    else {
-      ImGui::SameLine(0, 0);
-      details::Text(sub);
-    }
+    return context_store<Store>().entries;
   }
-}
 
-std::string pretty_typename(const std::string_view type_name)
-{
-  std::string s(type_name);
+  struct PrettyTypeName {
+    std::size_t max_columns;
+    std::string text;
+    int         last_used_frame;
+  };
 
-  if (s.size() < 130)
-    return s;
+  auto& get_pretty_type_names()
+  {
+    struct Store {
+      int                                                                             frame = -1;
+      std::unordered_map<std::string, PrettyTypeName, string_hasher, std::equal_to<>> entries;
+    };
 
+    return context_store<Store>().entries;
+  }
 
+  // Breaks the template argument lists that do not fit in `max_columns` over several lines, one argument per line,
+  // lists that fit are kept on one line. The width of every list is known upfront so this is a single pass.
+  std::string layout_pretty_type_name(const std::string_view name, const std::size_t max_columns)
   {
-    int                               indent_level = 0;
-    static constexpr std::string_view indent       = "    ";
-    for (std::size_t i = 0; i < s.size(); ++i) {
-      if (s[i] == '<') {
-        ++indent_level;
-        const auto amount = std::size_t(indent_level) * indent.size();
-        s.insert(i + 1, "\n" + std::string(amount, ' '));
-        i += 1 + amount;
+    static constexpr std::size_t indent_width = 4;
+
+    std::vector<std::size_t> closing(name.size(), std::string_view::npos);
+    {
+      std::vector<std::size_t> open;
+      for (std::size_t i = 0; i < name.size(); ++i) {
+        if (name[i] == '<')
+          open.push_back(i);
+        else if (name[i] == '>' && !open.empty()) {
+          closing[open.back()] = i;
+          open.pop_back();
+        }
+      }
+    }
+
+    struct List {
+      bool broken;
+      int  nesting; // parentheses and brackets opened inside the list, their commas do not break
+    };
+    std::vector<List> lists;
+
+    std::string r;
+    r.reserve(name.size() * 2);
+
+    std::size_t level  = 0;
+    std::size_t column = 0;
+    const auto  new_line = [&] {
+      r += '\n';
+      r.append(level * indent_width, ' ');
+      column = level * indent_width;
+    };
+
+    for (std::size_t i = 0; i < name.size(); ++i) {
+      const char c = name[i];
+      switch (c) {
+      case '<': {
+        r += c;
+        ++column;
+        const bool broken = closing[i] != std::string_view::npos && column + closing[i] - i > max_columns;
+        lists.push_back({broken, 0});
+        if (broken) {
+          ++level;
+          new_line();
+        }
+        break;
       }
-      else if (s[i] == '>') {
-        --indent_level;
-        const auto amount = std::size_t(indent_level) * indent.size();
-        s.insert(i, "\n" + std::string(amount, ' '));
-        i += 1 + amount;
+      case '>':
+        if (!lists.empty()) {
+          const bool broken = lists.back().broken;
+          lists.pop_back();
+          if (broken) {
+            --level;
+            new_line();
+          }
+        }
+        r += c;
+        ++column;
+        break;
+      case '(':
+      case '[':
+      case '{':
+        if (!lists.empty())
+          ++lists.back().nesting;
+        r += c;
+        ++column;
+        break;
+      case ')':
+      case ']':
+      case '}':
+        if (!lists.empty())
+          --lists.back().nesting;
+        r += c;
+        ++column;
+        break;
+      case ',':
+        r += c;
+        ++column;
+        if (!lists.empty() && lists.back().broken && lists.back().nesting == 0) {
+          new_line();
+          if (i + 1 < name.size() && name[i + 1] == ' ')
+            ++i;
+        }
+        break;
+      default:
+        r += c;
+        ++column;
       }
     }
+
+    return r;
+  }
+} // namespace
+
+void colored_pretty_typename(const std::string_view pretty, float indent)
+{
+  if (pretty.empty())
+    return;
+
+  auto& cache = get_colored_type_names();
+  auto  it    = cache.find(pretty);
+  if (it == cache.end())
+    it = cache.emplace(std::string(pretty), tokenize_colored_type_name(pretty)).first;
+
+  auto& name           = it->second;
+  name.last_used_frame = ImGui::GetFrameCount();
+  layout_colored_type_name(name);
+
+  const auto& colors = ImInspect::GetStyle().TypeHighlighter;
+  const ImU32 palette[] = {
+    ImGui::GetColorU32(ImVec4(colors.Text)),     ImGui::GetColorU32(ImVec4(colors.Bracket)),
+    ImGui::GetColorU32(ImVec4(colors.Symbol)),   ImGui::GetColorU32(ImVec4(colors.Operator)),
+    ImGui::GetColorU32(ImVec4(colors.Keyword)),  ImGui::GetColorU32(ImVec4(colors.Namespace)),
+    ImGui::GetColorU32(ImVec4(colors.Name)),
+  };
+
+  // continuation lines start at the left edge of the previous item plus `indent`. The cursor cannot be used since
+  // callers put the name on the same line as an item that starts the line, such as a label, which the first line
+  // continues.
+  const float line_start = ImGui::GetItemRectMin().x + indent;
+  ImGui::SameLine(0, 0);
+  const ImVec2 origin      = ImGui::GetCursorScreenPos();
+  const float  line_height = ImGui::GetTextLineHeight();
+
+  auto* const draw_list = ImGui::GetWindowDrawList();
+  const char* text      = name.text.data();
+  float       right     = origin.x;
+  for (std::uint32_t line = 0, i = 0; line < name.lines; ++line) {
+    const float x = line == 0 ? origin.x : line_start;
+    const float y = origin.y + float(line) * line_height;
+
+    const auto first = i;
+    while (i < name.spans.size() && name.spans[i].line == line)
+      ++i;
+
+    const float line_width = name.line_widths[line];
+    right                  = std::max(right, x + line_width);
+    if (!ImGui::IsRectVisible(ImVec2(x, y), ImVec2(x + line_width, y + line_height)))
+      continue;
+
+    for (auto j = first; j != i; ++j) {
+      const auto& span = name.spans[j];
+      draw_list->AddText(ImVec2(x + span.x, y), palette[std::size_t(span.color)], text + span.begin, text + span.end);
+    }
   }
 
-  return s;
+  ImGui::Dummy(ImVec2(right - origin.x, float(name.lines) * line_height));
+}
+
+std::string_view pretty_typename(const std::string_view type_name, const std::size_t max_columns)
+{
+  if (type_name.size() <= max_columns)
+    return type_name;
+
+  auto& cache = get_pretty_type_names();
+  auto  it    = cache.find(type_name);
+  if (it == cache.end())
+    it = cache.emplace(std::string(type_name), PrettyTypeName{max_columns, {}, 0}).first;
+
+  auto& pretty = it->second;
+  if (pretty.text.empty() || pretty.max_columns != max_columns) {
+    pretty.max_columns = max_columns;
+    pretty.text        = layout_pretty_type_name(type_name, max_columns);
+  }
+  pretty.last_used_frame = ImGui::GetFrameCount();
+  return pretty.text;
 }
 
 std::string_view to_string(const char* s) { return s; }
 
-void do_inspection(bool& b, const std::string& name) { 
-    ImGui::Checkbox(name.c_str(), &b); }
-void do_inspection(char& c, const std::string& name)
+bool do_inspection(bool& b, const Label name) { return ImGui::Checkbox(name.c_str(), &b); }
+bool do_inspection(char& c, const Label name)
 {
-  const ImSweet::ID id(name);
-  ImGui::InputText("", &c, 1);
+  const ImSweet::ID id(name.c_str());
+  const bool        changed = ImGui::InputText("", &c, 1);
   ImGui::SameLine();
-  ImInspect::display_label_with_type_tooltip(name, type_name<decltype(c)>);
+  ImInspect::display_label_with_type_tooltip(name, normalized_type_name<decltype(c)>);
+  return changed;
 }
 
-void do_inspection(void* p, const std::string& name) { ImInspect::display_readonly_data_voidptr(p, name); }
-void do_inspection(const void* p, const std::string& name) { ImInspect::display_readonly_data_voidptr(p, name); }
-void do_inspection(volatile void* p, const std::string& name) { ImInspect::display_readonly_data_voidptr(p, name); }
+bool do_inspection(void* p, const Label name)
+{
+  ImInspect::display_readonly_data_voidptr(p, name);
+  return false;
+}
+bool do_inspection(const void* p, const Label name)
+{
+  ImInspect::display_readonly_data_voidptr(p, name);
+  return false;
+}
+bool do_inspection(volatile void* p, const Label name)
+{
+  ImInspect::display_readonly_data_voidptr(p, name);
+  return false;
+}
 
-void do_inspection(const volatile void* const p, const std::string& name)
+bool do_inspection(const volatile void* const p, const Label name)
 {
   ImInspect::display_readonly_data_voidptr(p, name);
+  return false;
 }
 
-void do_inspection(const bool& b, const std::string& name)
+bool do_inspection(const bool& b, const Label name)
 {
   bool copy = b;
   ImGui::Checkbox(name.c_str(), &copy);
+  return false;
 }
-void do_inspection(const char& c, const std::string& name)
+bool do_inspection(const char& c, const Label name)
 {
   const char buf[3] = {'\'', c, '\''};
-  details::display_readonly_data(std::string_view(buf, sizeof(buf)), name, type_name<decltype(c)>);
+  details::display_readonly_data(std::string_view(buf, sizeof(buf)), name, normalized_type_name<decltype(c)>);
+  return false;
 }
 
-void do_inspection(std::string_view s, const std::string& name)
+bool do_inspection(std::string_view s, const Label name)
 {
-  details::display_readonly_data(s, name, type_name<decltype(s)>);
+  details::display_readonly_data(s, name, normalized_type_name<decltype(s)>);
+  return false;
 }
 
-void do_inspection(const std::string& s, const std::string& name)
+bool do_inspection(const std::string& s, const Label name)
 {
-  details::display_readonly_data(s, name, type_name<decltype(s)>);
+  details::display_readonly_data(s, name, normalized_type_name<decltype(s)>);
+  return false;
 }
 
-void do_inspection(std::string& s, const std::string& name)
+bool do_inspection(std::string& s, const Label name)
 {
-  const ImSweet::ID id(name);
-  ImGui::InputText("", &s);
+  if (s.size() > ImInspect::GetConfig().LargeStringThreshold)
+    return ImInspect::large_string(s, &s, name, normalized_type_name<decltype(s)>);
+
+  const ImSweet::ID id(name.c_str());
+  const bool        changed = ImGui::InputText("", &s);
   ImGui::SameLine();
-  ImInspect::display_label_with_type_tooltip(name, type_name<decltype(s)>);
+  ImInspect::display_label_with_type_tooltip(name, normalized_type_name<decltype(s)>);
+  return changed;
 }
 
 
-void do_inspection(ImVec4& v, const std::string& name)
+bool do_inspection(ImVec4& v, const Label name)
 {
-  const ImSweet::ID id(name);
-  ImGui::InputFloat4("", &v.x);
+  const ImSweet::ID id(name.c_str());
+  const bool        changed = ImGui::InputFloat4("", &v.x);
   ImGui::SameLine();
-  ImInspect::display_label_with_type_tooltip(name, type_name<decltype(v)>);
+  ImInspect::display_label_with_type_tooltip(name, normalized_type_name<decltype(v)>);
+  return changed;
 }
-void do_inspection(const ImVec4& v, const std::string& name)
+bool do_inspection(const ImVec4& v, const Label name)
 {
-  const ImSweet::ID id(name);
+  const ImSweet::ID id(name.c_str());
   auto              c = v;
   ImGui::InputFloat4("", &c.x, "%.3f", ImGuiInputTextFlags_::ImGuiInputTextFlags_ReadOnly);
   if (ImGui::IsItemHovered())
     details::red_tooltip("Cannot edit this field it is not writable.");
   ImGui::SameLine();
-  ImInspect::display_label_with_type_tooltip(name, type_name<decltype(v)>);
+  ImInspect::display_label_with_type_tooltip(name, normalized_type_name<decltype(v)>);
+  return false;
 }
-void do_inspection(ImVec2& v, const std::string& name)
+bool do_inspection(ImVec2& v, const Label name)
 {
-  const ImSweet::ID id(name);
-  ImGui::InputFloat2("", &v.x);
+  const ImSweet::ID id(name.c_str());
+  const bool        changed = ImGui::InputFloat2("", &v.x);
   ImGui::SameLine();
-  ImInspect::display_label_with_type_tooltip(name, type_name<decltype(v)>);
+  ImInspect::display_label_with_type_tooltip(name, normalized_type_name<decltype(v)>);
+  return changed;
 }
-void do_inspection(const ImVec2& v, const std::string& name)
+bool do_inspection(const ImVec2& v, const Label name)
 {
-  const ImSweet::ID id(name);
+  const ImSweet::ID id(name.c_str());
   auto              c = v;
   ImGui::InputFloat2("", &c.x, "%.3f", ImGuiInputTextFlags_::ImGuiInputTextFlags_ReadOnly);
   if (ImGui::IsItemHovered())
     details::red_tooltip("Cannot edit this field it is not writable.");
   ImGui::SameLine();
-  ImInspect::display_label_with_type_tooltip(name, type_name<decltype(v)>);
+  ImInspect::display_label_with_type_tooltip(name, normalized_type_name<decltype(v)>);
+  return false;
 }
-void do_inspection(ImColor& c, const std::string& name)
+bool do_inspection(ImColor& c, const Label name)
 {
-  const ImSweet::ID id(name);
-  ImGui::ColorEdit4("", &c.Value.x);
+  const ImSweet::ID id(name.c_str());
+  const bool        changed = ImGui::ColorEdit4("", &c.Value.x);
   ImGui::SameLine();
-  ImInspect::display_label_with_type_tooltip(name, type_name<decltype(c)>);
+  ImInspect::display_label_with_type_tooltip(name, normalized_type_name<decltype(c)>);
+  return changed;
 }
-void do_inspection(const ImColor& c, const std::string& name)
+bool do_inspection(const ImColor& c, const Label name)
 {
-  const ImSweet::ID id(name);
+  const ImSweet::ID id(name.c_str());
   auto              copy = c;
   ImGui::ColorEdit4("", &copy.Value.x, ImGuiInputTextFlags_::ImGuiInputTextFlags_ReadOnly);
   if (ImGui::IsItemHovered())
     details::red_tooltip("Cannot edit this field it is not writable.");
   ImGui::SameLine();
-  ImInspect::display_label_with_type_tooltip(name, type_name<decltype(c)>);
+  ImInspect::display_label_with_type_tooltip(name, normalized_type_name<decltype(c)>);
+  return false;
 }
 
 namespace details {
 
-  void display_function_pointer(void (*f)(), const std::string& name, std::string_view type_name)
+  ImGuiDataType_ map_int_type_to_imgui(const std::size_t size, const bool is_unsigned)
+  {
+    static_assert(CHAR_BIT == 8, "This library requires 8 bit systems");
+    switch (size) {
+      case 1:
+        return is_unsigned ? ImGuiDataType_U8 : ImGuiDataType_S8;
+      case 2:
+        return is_unsigned ? ImGuiDataType_U16 : ImGuiDataType_S16;
+      case 4:
+        return is_unsigned ? ImGuiDataType_U32 : ImGuiDataType_S32;
+      case 8:
+        return is_unsigned ? ImGuiDataType_U64 : ImGuiDataType_S64;
+    }
+    return (assert(!"Invalid type passed"), ImGuiDataType_U8);
+  }
+
+  void display_function_pointer(void (*f)(), const Label name, std::string_view type_name)
   {
     if (f != nullptr) {
       if constexpr (sizeof(f) == sizeof(void*)) {
-        details::display_readonly_data(std::format("0x{:016x}", reinterpret_cast<std::uintptr_t>(f)), name, type_name);
+        details::display_readonly_data(details::frame_format("0x{:016x}", reinterpret_cast<std::uintptr_t>(f)),
+                                       name,
+                                       type_name);
       }
       else {
         details::display_readonly_data("<cannot display function pointer on this architecture>", name, type_name);
@@ -489,28 +1493,452 @@ namespace details {
   }
 
 
-  void modify_numeric_float(void* const p, const std::string& name, const bool is_double, const std::string_view type_name)
+  bool modify_numeric_float(void* const p, const Label name, const bool is_double, const std::string_view type_name)
   {
-    const ImSweet::ID id(name);
+    const ImSweet::ID id(name.c_str());
 
-    if (is_double)
-      ImGui::InputDouble("", static_cast<double*>(p));
-    else
-      ImGui::InputFloat("", static_cast<float*>(p));
+    const bool changed =
+      is_double ? ImGui::InputDouble("", static_cast<double*>(p)) : ImGui::InputFloat("", static_cast<float*>(p));
     ImGui::SameLine();
     ImInspect::display_label_with_type_tooltip(name, type_name);
+    return changed;
   }
 
-  void modify_numeric_int(void* const            p,
-                          const std::string&     name,
+  bool modify_numeric_grid(void* const           p,
+                           const Label            name,
+                           const ImGuiDataType    data_type,
+                           const std::size_t      element_size,
+                           const int              columns,
+                           const int              rows,
+                           const bool             read_only,
+                           const std::string_view type_name)
+  {
+    const ImSweet::ID id(name.c_str());
+
+    bool changed = false;
+    for (int r = 0; r < rows; ++r) {
+      const ImSweet::ID row_id(r);
+      changed |= ImGui::InputScalarN("",
+                                     data_type,
+                                     static_cast<char*>(p) + std::size_t(r) * std::size_t(columns) * element_size,
+                                     columns,
+                                     nullptr,
+                                     nullptr,
+                                     nullptr,
+                                     read_only ? ImGuiInputTextFlags_ReadOnly : ImGuiInputTextFlags_None);
+      if (r == 0) {
+        ImGui::SameLine();
+        ImInspect::display_label_with_type_tooltip(name, type_name);
+      }
+    }
+    return changed;
+  }
+
+  bool modify_numeric_int(void* const            p,
+                          const Label            name,
                           const std::size_t      size,
                           const bool             is_unsigned,
                           const std::string_view type_name)
   {
-    const ImSweet::ID id(name);
-    ImGui::InputScalar("", ImInspect::map_int_type_to_imgui(size, is_unsigned), p);
+    const ImSweet::ID id(name.c_str());
+    const bool        changed = ImGui::InputScalar("", details::map_int_type_to_imgui(size, is_unsigned), p);
     ImGui::SameLine();
     ImInspect::display_label_with_type_tooltip(name, type_name);
+    return changed;
+  }
+
+  void NumericSummary::rebuild_levels()
+  {
+    levels.resize(1);
+    while (levels.back().size() > 1) {
+      const auto&         below = levels.back();
+      std::vector<MinMax> above((below.size() + 1) / 2);
+      for (std::size_t i = 0; i < below.size(); ++i)
+        above[i / 2].add(below[i]);
+      levels.push_back(std::move(above));
+    }
+  }
+
+  void NumericSummary::update_block(std::size_t b, const MinMax m)
+  {
+    levels[0][b] = m;
+    for (std::size_t level = 1; level < levels.size(); ++level) {
+      const auto& below = levels[level - 1];
+      b /= 2;
+
+      MinMax parent = below[2 * b];
+      if (2 * b + 1 < below.size())
+        parent.add(below[2 * b + 1]);
+      levels[level][b] = parent;
+    }
+  }
+
+  void range_view_selector(int& view)
+  {
+    ImGui::RadioButton("Rows", &view, static_cast<int>(RangeView::Rows));
+    ImGui::SameLine();
+    ImGui::RadioButton("Plot", &view, static_cast<int>(RangeView::Plot));
+    ImGui::SameLine();
+    ImGui::RadioButton("Histogram", &view, static_cast<int>(RangeView::Histogram));
+    ImGui::SameLine();
+    ImGui::RadioButton("Heatmap", &view, static_cast<int>(RangeView::Heatmap));
+  }
+
+  void draw_min_max_plot(const std::span<const MinMax> columns, const MinMax bounds, const std::size_t count)
+  {
+    const ImVec2 p0 = ImGui::GetCursorScreenPos();
+    const ImVec2 size(ImGui::GetContentRegionAvail().x, ImGui::GetFrameHeight() * 6);
+    const ImVec2 p1(p0.x + size.x, p0.y + size.y);
+    ImGui::InvisibleButton("##plot", size);
+
+    auto* const draw_list = ImGui::GetWindowDrawList();
+    draw_list->AddRectFilled(p0, p1, ImGui::GetColorU32(ImGuiCol_FrameBg));
+    if (columns.empty() || bounds.empty())
+      return;
+
+    // one bar from the smallest to the largest value per column, at least a pixel high
+    const float range = bounds.hi > bounds.lo ? bounds.hi - bounds.lo : 1.0f;
+    const float step  = size.x / static_cast<float>(columns.size());
+    const auto  y     = [&](const float v) { return p1.y - (v - bounds.lo) / range * size.y; };
+    const ImU32 color = ImGui::GetColorU32(ImGuiCol_PlotLines);
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+      if (columns[i].empty())
+        continue;
+      const float x   = p0.x + static_cast<float>(i) * step;
+      const float top = y(columns[i].hi);
+      draw_list->AddRectFilled(ImVec2(x, top), ImVec2(x + std::max(step, 1.0f), std::max(y(columns[i].lo), top + 1)), color);
+    }
+
+    if (ImGui::IsItemHovered()) {
+      const auto i = std::min(static_cast<std::size_t>(std::max(ImGui::GetMousePos().x - p0.x, 0.0f) / step),
+                              columns.size() - 1);
+      ImGui::SetTooltip("[%zu, %zu)\nmin %g\nmax %g",
+                        i * count / columns.size(),
+                        (i + 1) * count / columns.size(),
+                        columns[i].lo,
+                        columns[i].hi);
+    }
+    ImGui::TextDisabled("%zu values in [%g, %g]", count, bounds.lo, bounds.hi);
+  }
+
+  void draw_histogram(const std::span<const float> bins, const MinMax bounds, const std::size_t count)
+  {
+    ImGui::PlotHistogram("##histogram",
+                         bins.data(),
+                         static_cast<int>(bins.size()),
+                         0,
+                         nullptr,
+                         0.0f,
+                         FLT_MAX,
+                         ImVec2(-FLT_MIN, ImGui::GetFrameHeight() * 6));
+    if (!bounds.empty())
+      ImGui::TextDisabled("%zu values in [%g, %g], %zu bins", count, bounds.lo, bounds.hi, bins.size());
+  }
+
+  void draw_heatmap(const std::span<const float> cells,
+                    const int                    columns,
+                    const int                    rows,
+                    const MinMax                 bounds,
+                    const int                    width,
+                    const int                    height)
+  {
+    const ImVec2 p0 = ImGui::GetCursorScreenPos();
+    const float  w  = ImGui::GetContentRegionAvail().x;
+    const ImVec2 size(w, std::clamp(w * static_cast<float>(height) / static_cast<float>(width), 16.0f, 320.0f));
+    ImGui::InvisibleButton("##heatmap", size);
+    if (cells.empty() || bounds.empty())
+      return;
+
+    const ImVec4 low(0.05f, 0.05f, 0.35f, 1.0f);
+    const ImVec4 high(1.0f, 0.85f, 0.1f, 1.0f);
+    const float  range = bounds.hi > bounds.lo ? bounds.hi - bounds.lo : 1.0f;
+    const ImVec2 cell(size.x / static_cast<float>(columns), size.y / static_cast<float>(rows));
+
+    auto* const draw_list = ImGui::GetWindowDrawList();
+    for (int y = 0; y < rows; ++y) {
+      for (int x = 0; x < columns; ++x) {
+        const float v = cells[static_cast<std::size_t>(y) * columns + x];
+        if (std::isnan(v))
+          continue;
+        const float  t = (v - bounds.lo) / range;
+        const ImVec4 c(low.x + (high.x - low.x) * t, low.y + (high.y - low.y) * t, low.z + (high.z - low.z) * t, 1.0f);
+        const ImVec2 a(p0.x + static_cast<float>(x) * cell.x, p0.y + static_cast<float>(y) * cell.y);
+        draw_list->AddRectFilled(a, ImVec2(a.x + cell.x, a.y + cell.y), ImGui::ColorConvertFloat4ToU32(c));
+      }
+    }
+
+    if (ImGui::IsItemHovered()) {
+      const auto mouse = ImGui::GetMousePos();
+      const int  x     = std::clamp(static_cast<int>((mouse.x - p0.x) / cell.x), 0, columns - 1);
+      const int  y     = std::clamp(static_cast<int>((mouse.y - p0.y) / cell.y), 0, rows - 1);
+      ImGui::SetTooltip("rows [%d, %d), columns [%d, %d)\nmax %g",
+                        y * height / rows,
+                        (y + 1) * height / rows,
+                        x * width / columns,
+                        (x + 1) * width / columns,
+                        cells[static_cast<std::size_t>(y) * columns + x]);
+    }
+    ImGui::TextDisabled("%d x %d, largest value per cell in [%g, %g]", width, height, bounds.lo, bounds.hi);
+  }
+
+  // The kernels below keep NaN and infinite lanes out of the extremes by replacing them with infinities of the
+  // right sign, and out of the sums by replacing them with the shift. The shift is one of the values,
+  // so it is exact in float and those lanes add exactly zero.
+#if defined(__AVX__)
+
+  void accumulate_stats(NumericStats& s, const float* const p, const std::size_t n, const double shift)
+  {
+    const __m256  zero    = _mm256_setzero_ps();
+    const __m256  pos_inf = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+    const __m256  neg_inf = _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+    const __m256  k       = _mm256_set1_ps(static_cast<float>(shift));
+    const __m256d kd      = _mm256_set1_pd(shift);
+
+    __m256      lo = pos_inf, hi = neg_inf;
+    __m256d     sum0 = _mm256_setzero_pd(), sum1 = sum0, sq0 = sum0, sq1 = sum0;
+    std::size_t finite = 0, nan = 0, i = 0;
+    for (; i + 8 <= n; i += 8) {
+      const __m256 x    = _mm256_loadu_ps(p + i);
+      const __m256 mask = _mm256_cmp_ps(_mm256_sub_ps(x, x), zero, _CMP_EQ_OQ);
+      finite += std::popcount(static_cast<unsigned>(_mm256_movemask_ps(mask)));
+      nan += std::popcount(static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(x, x, _CMP_UNORD_Q))));
+
+      lo                = _mm256_min_ps(lo, _mm256_blendv_ps(pos_inf, x, mask));
+      hi                = _mm256_max_ps(hi, _mm256_blendv_ps(neg_inf, x, mask));
+      const __m256  v   = _mm256_blendv_ps(k, x, mask);
+      const __m256d d0  = _mm256_sub_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(v)), kd);
+      const __m256d d1  = _mm256_sub_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)), kd);
+      sum0              = _mm256_add_pd(sum0, d0);
+      sum1              = _mm256_add_pd(sum1, d1);
+      sq0               = _mm256_add_pd(sq0, _mm256_mul_pd(d0, d0));
+      sq1               = _mm256_add_pd(sq1, _mm256_mul_pd(d1, d1));
+    }
+
+    alignas(32) float  l[8], h[8];
+    alignas(32) double a[4], b[4];
+    _mm256_store_ps(l, lo);
+    _mm256_store_ps(h, hi);
+    _mm256_store_pd(a, _mm256_add_pd(sum0, sum1));
+    _mm256_store_pd(b, _mm256_add_pd(sq0, sq1));
+    for (int j = 0; j < 8; ++j) {
+      s.lo = std::min(s.lo, static_cast<double>(l[j]));
+      s.hi = std::max(s.hi, static_cast<double>(h[j]));
+    }
+    s.sum += a[0] + a[1] + a[2] + a[3];
+    s.sum_squares += b[0] + b[1] + b[2] + b[3];
+    s.finite += finite;
+    s.nan += nan;
+    s.inf += i - finite - nan;
+
+    details::accumulate_stats<float>(s, p + i, n - i, shift);
+  }
+
+  void accumulate_stats(NumericStats& s, const double* const p, const std::size_t n, const double shift)
+  {
+    const __m256d zero    = _mm256_setzero_pd();
+    const __m256d pos_inf = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+    const __m256d neg_inf = _mm256_set1_pd(-std::numeric_limits<double>::infinity());
+    const __m256d k       = _mm256_set1_pd(shift);
+
+    __m256d     lo = pos_inf, hi = neg_inf, sum = zero, sq = zero;
+    std::size_t finite = 0, nan = 0, i = 0;
+    for (; i + 4 <= n; i += 4) {
+      const __m256d x    = _mm256_loadu_pd(p + i);
+      const __m256d mask = _mm256_cmp_pd(_mm256_sub_pd(x, x), zero, _CMP_EQ_OQ);
+      finite += std::popcount(static_cast<unsigned>(_mm256_movemask_pd(mask)));
+      nan += std::popcount(static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(x, x, _CMP_UNORD_Q))));
+
+      lo              = _mm256_min_pd(lo, _mm256_blendv_pd(pos_inf, x, mask));
+      hi              = _mm256_max_pd(hi, _mm256_blendv_pd(neg_inf, x, mask));
+      const __m256d d = _mm256_sub_pd(_mm256_blendv_pd(k, x, mask), k);
+      sum             = _mm256_add_pd(sum, d);
+      sq              = _mm256_add_pd(sq, _mm256_mul_pd(d, d));
+    }
+
+    alignas(32) double l[4], h[4], a[4], b[4];
+    _mm256_store_pd(l, lo);
+    _mm256_store_pd(h, hi);
+    _mm256_store_pd(a, sum);
+    _mm256_store_pd(b, sq);
+    for (int j = 0; j < 4; ++j) {
+      s.lo = std::min(s.lo, l[j]);
+      s.hi = std::max(s.hi, h[j]);
+      s.sum += a[j];
+      s.sum_squares += b[j];
+    }
+    s.finite += finite;
+    s.nan += nan;
+    s.inf += i - finite - nan;
+
+    details::accumulate_stats<double>(s, p + i, n - i, shift);
+  }
+
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+  // SSE2 has no blend, select(mask, a, b) is (mask & a) | (~mask & b).
+  inline __m128 select(const __m128 mask, const __m128 a, const __m128 b)
+  {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+  }
+
+  inline __m128d select(const __m128d mask, const __m128d a, const __m128d b)
+  {
+    return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b));
+  }
+
+  void accumulate_stats(NumericStats& s, const float* const p, const std::size_t n, const double shift)
+  {
+    const __m128  zero    = _mm_setzero_ps();
+    const __m128  pos_inf = _mm_set1_ps(std::numeric_limits<float>::infinity());
+    const __m128  neg_inf = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+    const __m128  k       = _mm_set1_ps(static_cast<float>(shift));
+    const __m128d kd      = _mm_set1_pd(shift);
+
+    __m128      lo = pos_inf, hi = neg_inf;
+    __m128d     sum0 = _mm_setzero_pd(), sum1 = sum0, sq0 = sum0, sq1 = sum0;
+    std::size_t finite = 0, nan = 0, i = 0;
+    for (; i + 4 <= n; i += 4) {
+      const __m128 x    = _mm_loadu_ps(p + i);
+      const __m128 mask = _mm_cmpeq_ps(_mm_sub_ps(x, x), zero);
+      finite += std::popcount(static_cast<unsigned>(_mm_movemask_ps(mask)));
+      nan += std::popcount(static_cast<unsigned>(_mm_movemask_ps(_mm_cmpunord_ps(x, x))));
+
+      lo                = _mm_min_ps(lo, select(mask, x, pos_inf));
+      hi                = _mm_max_ps(hi, select(mask, x, neg_inf));
+      const __m128  v   = select(mask, x, k);
+      const __m128d d0  = _mm_sub_pd(_mm_cvtps_pd(v), kd);
+      const __m128d d1  = _mm_sub_pd(_mm_cvtps_pd(_mm_movehl_ps(v, v)), kd);
+      sum0              = _mm_add_pd(sum0, d0);
+      sum1              = _mm_add_pd(sum1, d1);
+      sq0               = _mm_add_pd(sq0, _mm_mul_pd(d0, d0));
+      sq1               = _mm_add_pd(sq1, _mm_mul_pd(d1, d1));
+    }
+
+    alignas(16) float  l[4], h[4];
+    alignas(16) double a[2], b[2];
+    _mm_store_ps(l, lo);
+    _mm_store_ps(h, hi);
+    _mm_store_pd(a, _mm_add_pd(sum0, sum1));
+    _mm_store_pd(b, _mm_add_pd(sq0, sq1));
+    for (int j = 0; j < 4; ++j) {
+      s.lo = std::min(s.lo, static_cast<double>(l[j]));
+      s.hi = std::max(s.hi, static_cast<double>(h[j]));
+    }
+    s.sum += a[0] + a[1];
+    s.sum_squares += b[0] + b[1];
+    s.finite += finite;
+    s.nan += nan;
+    s.inf += i - finite - nan;
+
+    details::accumulate_stats<float>(s, p + i, n - i, shift);
+  }
+
+  void accumulate_stats(NumericStats& s, const double* const p, const std::size_t n, const double shift)
+  {
+    const __m128d zero    = _mm_setzero_pd();
+    const __m128d pos_inf = _mm_set1_pd(std::numeric_limits<double>::infinity());
+    const __m128d neg_inf = _mm_set1_pd(-std::numeric_limits<double>::infinity());
+    const __m128d k       = _mm_set1_pd(shift);
+
+    __m128d     lo = pos_inf, hi = neg_inf, sum = zero, sq = zero;
+    std::size_t finite = 0, nan = 0, i = 0;
+    for (; i + 2 <= n; i += 2) {
+      const __m128d x    = _mm_loadu_pd(p + i);
+      const __m128d mask = _mm_cmpeq_pd(_mm_sub_pd(x, x), zero);
+      finite += std::popcount(static_cast<unsigned>(_mm_movemask_pd(mask)));
+      nan += std::popcount(static_cast<unsigned>(_mm_movemask_pd(_mm_cmpunord_pd(x, x))));
+
+      lo              = _mm_min_pd(lo, select(mask, x, pos_inf));
+      hi              = _mm_max_pd(hi, select(mask, x, neg_inf));
+      const __m128d d = _mm_sub_pd(select(mask, x, k), k);
+      sum             = _mm_add_pd(sum, d);
+      sq              = _mm_add_pd(sq, _mm_mul_pd(d, d));
+    }
+
+    alignas(16) double l[2], h[2], a[2], b[2];
+    _mm_store_pd(l, lo);
+    _mm_store_pd(h, hi);
+    _mm_store_pd(a, sum);
+    _mm_store_pd(b, sq);
+    for (int j = 0; j < 2; ++j) {
+      s.lo = std::min(s.lo, l[j]);
+      s.hi = std::max(s.hi, h[j]);
+      s.sum += a[j];
+      s.sum_squares += b[j];
+    }
+    s.finite += finite;
+    s.nan += nan;
+    s.inf += i - finite - nan;
+
+    details::accumulate_stats<double>(s, p + i, n - i, shift);
+  }
+
+#else
+
+  void accumulate_stats(NumericStats& s, const float* const p, const std::size_t n, const double shift)
+  {
+    details::accumulate_stats<float>(s, p, n, shift);
+  }
+
+  void accumulate_stats(NumericStats& s, const double* const p, const std::size_t n, const double shift)
+  {
+    details::accumulate_stats<double>(s, p, n, shift);
+  }
+
+#endif
+
+  void print_memory_info(const std::size_t element_size, const std::size_t size, const std::size_t capacity)
+  {
+    details::Text(details::frame_format("Bytes: {}", element_size * size));
+    if (capacity != std::size_t(-1)) {
+      details::Text(details::frame_format("Capacity: {} ({} bytes)", capacity, element_size * capacity));
+    }
+  }
+
+  void print_container_stats(ContainerStats& stats)
+  {
+    ImGui::Separator();
+    if (!stats.ready) {
+      const auto passes = static_cast<float>(stats.binning ? stats.size + stats.done : stats.done);
+      ImGui::ProgressBar(stats.size != 0 ? passes / (2.0f * static_cast<float>(stats.size)) : 1.0f);
+      return;
+    }
+
+    const auto& s = stats.stats;
+    if (s.finite != 0) {
+      const double n        = static_cast<double>(s.finite);
+      const double mean     = s.sum / n;
+      const double variance = std::max(s.sum_squares / n - mean * mean, 0.0);
+      details::Text(details::frame_format("Min: {}", s.lo));
+      details::Text(details::frame_format("Max: {}", s.hi));
+      details::Text(details::frame_format("Mean: {}", stats.shift + mean));
+      details::Text(details::frame_format("Standard deviation: {}", std::sqrt(variance)));
+    }
+    details::Text(details::frame_format("NaN: {}", s.nan));
+    details::Text(details::frame_format("Infinite: {}", s.inf));
+    if (s.finite != 0) {
+      ImGui::PlotHistogram("##histogram",
+                           stats.bins.data(),
+                           static_cast<int>(stats.bins.size()),
+                           0,
+                           nullptr,
+                           0.0f,
+                           FLT_MAX,
+                           ImVec2(ImGui::GetFontSize() * 16, ImGui::GetFrameHeight() * 3));
+    }
+    // the next update starts over from the data, which also takes a new shift
+    if (ImGui::SmallButton("Refresh"))
+      stats.data = nullptr;
+  }
+
+  bool print_hex_view(const std::span<unsigned char> bytes)
+  {
+    return hex_view(std::span<const unsigned char>(bytes), bytes.data());
+  }
+
+  bool print_hex_view(const std::span<const unsigned char> bytes)
+  {
+    return hex_view(bytes, nullptr);
   }
 
   void print_more_container_info(const std::size_t count)
@@ -520,17 +1948,329 @@ namespace details {
   }
 
 
-  void inspect_filesystem_path(void* const fs, const std::string& name)
+  std::pmr::memory_resource& frame_memory()
+  {
+    thread_local struct {
+      int                   frame = -1;
+      ImInspect::FrameArena arena;
+    } memory;
+
+    const int frame = ImGui::GetFrameCount();
+    if (memory.frame != frame) {
+      memory.frame = frame;
+      memory.arena.rewind();
+    }
+    return memory.arena;
+  }
+
+  std::uint64_t hash_bytes(const void* const data, const std::size_t size, const std::uint64_t seed)
+  {
+    const auto*   p      = static_cast<const unsigned char*>(data);
+    std::uint64_t acc[2] = {0, 0};
+    std::size_t   i      = 0;
+
+#if defined(__AVX2__)
+    // two stripes per iteration, lanes 0 and 1 belong to the even stripe and lanes 2 and 3 to the odd one
+    if (size >= 32) {
+      const __m256i step = _mm256_set1_epi64x(static_cast<long long>(2 * hash_step));
+      __m256i       key  = _mm256_set_epi64x(static_cast<long long>(hash_key1 + hash_step),
+                                      static_cast<long long>(hash_key0 + hash_step),
+                                      static_cast<long long>(hash_key1),
+                                      static_cast<long long>(hash_key0));
+      __m256i       sum  = _mm256_setzero_si256();
+      for (; i + 32 <= size; i += 32) {
+        const __m256i d       = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        const __m256i x       = _mm256_xor_si256(d, key);
+        const __m256i product = _mm256_mul_epu32(x, _mm256_shuffle_epi32(x, _MM_SHUFFLE(0, 3, 0, 1)));
+        sum = _mm256_add_epi64(sum, _mm256_add_epi64(_mm256_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2)), product));
+        key = _mm256_add_epi64(key, step);
+      }
+      alignas(32) std::uint64_t lanes[4];
+      _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sum);
+      acc[0] += lanes[0] + lanes[2];
+      acc[1] += lanes[1] + lanes[3];
+    }
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    if (size >= 16) {
+      const __m128i step = _mm_set1_epi64x(static_cast<long long>(hash_step));
+      __m128i key = _mm_set_epi64x(static_cast<long long>(hash_key1), static_cast<long long>(hash_key0));
+      __m128i sum = _mm_setzero_si128();
+      for (; i + 16 <= size; i += 16) {
+        const __m128i d       = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        const __m128i x       = _mm_xor_si128(d, key);
+        const __m128i product = _mm_mul_epu32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(0, 3, 0, 1)));
+        sum = _mm_add_epi64(sum, _mm_add_epi64(_mm_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2)), product));
+        key = _mm_add_epi64(key, step);
+      }
+      alignas(16) std::uint64_t lanes[2];
+      _mm_store_si128(reinterpret_cast<__m128i*>(lanes), sum);
+      acc[0] += lanes[0];
+      acc[1] += lanes[1];
+    }
+#endif
+
+    for (; i + 16 <= size; i += 16)
+      ImInspect::hash_stripe(acc, p + i, hash_key0 + (i / 16) * hash_step, hash_key1 + (i / 16) * hash_step);
+    if (i != size) {
+      unsigned char tail[16] = {};
+      std::memcpy(tail, p + i, size - i);
+      ImInspect::hash_stripe(acc, tail, hash_key0 + (i / 16) * hash_step, hash_key1 + (i / 16) * hash_step);
+    }
+
+    std::uint64_t h = ImInspect::fmix64(seed ^ (size * hash_key1));
+    h               = ImInspect::fmix64(h ^ acc[0]);
+    return ImInspect::fmix64(h ^ acc[1]);
+  }
+
+  ChangeHighlight::ChangeHighlight(const Label             name,
+                                   const void* const       value,
+                                   std::uint64_t (*const hash)(const void*),
+                                   const std::uint64_t     shallow)
+    : value(value), hash(hash), shallow(shallow)
+  {
+    auto& store = ImInspect::get_change_store();
+    parent      = store.open;
+    store.open  = this;
+    id          = ImInspect::inspected_node_id(name);
+    top_left    = ImGui::GetCursorScreenPos();
+    right       = top_left.x + ImGui::GetContentRegionAvail().x;
+  }
+
+  ChangeHighlight::~ChangeHighlight()
+  {
+    auto& store = ImInspect::get_change_store();
+    store.open  = parent;
+
+    // nested values were hashed on their own, hashing them again here would walk the same values once per level
+    const std::uint64_t h   = nested ? shallow : hash(value);
+    const double        now = ImGui::GetTime();
+
+    const auto [it, inserted] = store.entries.try_emplace(id, ChangeEntry{h, store.frame, -1e9, nested});
+    auto& entry               = it->second;
+    // the same id twice in one frame is a collision, not a change
+    const bool compared = !inserted && entry.last_used_frame != store.frame && entry.nested == nested;
+    const bool changed  = (compared && entry.hash != h) || nested_changed;
+    if (changed)
+      entry.changed_at = now;
+    entry.hash            = h;
+    entry.nested          = nested;
+    entry.last_used_frame = store.frame;
+
+    if (parent != nullptr) {
+      parent->nested = true;
+      parent->nested_changed |= changed;
+    }
+
+    const float seconds = ImInspect::GetConfig().ChangeFlashSeconds;
+    const float alpha   = seconds > 0 ? 1.0f - static_cast<float>(now - entry.changed_at) / seconds : 0.0f;
+    if (alpha <= 0)
+      return;
+
+    const float row    = ImGui::GetFrameHeight();
+    const float bottom = nested ? top_left.y + row : std::max(ImGui::GetCursorScreenPos().y, top_left.y + row);
+    ImGui::GetWindowDrawList()->AddRectFilled(
+      top_left, ImVec2(right, bottom), ImGui::GetColorU32(ImGuiCol_PlotHistogram, std::min(alpha, 1.0f) * 0.35f));
+  }
+
+  Label cached_text(const Label             name,
+                    const std::uint64_t     hash,
+                    const bool              hashed,
+                    void (*const format)(const void*, std::string&),
+                    const void* const       value)
+  {
+    auto&        store        = ImInspect::get_text_store();
+    const double now          = ImGui::GetTime();
+    const auto [it, inserted] = store.entries.try_emplace(ImInspect::inspected_node_id(name));
+    auto&        entry        = it->second;
+    const auto   next_rate    = std::exchange(store.next_rate, std::nullopt);
+
+    // the same id twice in one frame is a collision, the second value is formatted without the cache so neither
+    // shows the text of the other and the text handed out before stays as it is
+    if (!inserted && entry.last_used_frame == store.frame) {
+      std::string text;
+      format(value, text);
+      return details::frame_string(text);
+    }
+
+    if (next_rate)
+      entry.rate = *next_rate;
+    const float rate  = entry.rate >= 0 ? entry.rate : ImInspect::GetConfig().ReadOnlyRefreshRate;
+    const bool  stale = inserted || !hashed || entry.hash != hash;
+    if (stale && (inserted || rate <= 0 || now - entry.formatted_at >= 1.0 / rate)) {
+      // the string keeps its capacity, so formatting again does not allocate once it is large enough
+      entry.text.clear();
+      format(value, entry.text);
+      entry.hash         = hash;
+      entry.formatted_at = now;
+    }
+    entry.last_used_frame = store.frame;
+    return entry.text;
+  }
+
+  InspectionScope::InspectionScope(const Label name, const volatile void* const address, const void* const type)
+  {
+    auto& state = ImInspect::get_inspection_state();
+    state.path.push_back(name);
+    // a pointer back to the root links to it instead of expanding it once more
+    if (state.depth == 0 && address != nullptr)
+      details::mark_shown_pointee(address, type);
+    deep = ++state.depth > ImInspect::GetConfig().MaxDepth;
+  }
+
+  InspectionScope::~InspectionScope()
+  {
+    auto& state = ImInspect::get_inspection_state();
+    state.path.pop_back();
+    --state.depth;
+  }
+
+  const ShownPointee* find_shown_pointee(const volatile void* const address, const void* const type)
+  {
+    const auto& shown = ImInspect::get_inspection_state().shown;
+    const auto  it    = shown.find({address, type});
+    return it != shown.end() ? &it->second : nullptr;
+  }
+
+  void mark_shown_pointee(const volatile void* const address, const void* const type)
+  {
+    auto& state = ImInspect::get_inspection_state();
+
+    // the cursor is still in the window the pointee is drawn in, which may be a clipped region and not the window
+    // of the link, right after the row that opened it
+    if (state.scroll_frame + 1 == state.frame && state.scroll_to == PointeeKey{address, type}) {
+      ImGui::SetScrollHereY(0.0f);
+      state.scroll_frame = -1;
+    }
+
+    // "a.b[2].c", the path is only formatted for pointees that get expanded
+    std::size_t size = 0;
+    for (const auto label : state.path)
+      size += label.size() + 1;
+
+    auto* const text = static_cast<char*>(details::frame_memory().allocate(size + 1, alignof(char)));
+    std::size_t n    = 0;
+    for (const auto label : state.path) {
+      if (label.empty())
+        continue;
+      if (n != 0 && label.view().front() != '[')
+        text[n++] = '.';
+      std::memcpy(text + n, label.c_str(), label.size());
+      n += label.size();
+    }
+    text[n] = '\0';
+
+    state.shown.try_emplace({address, type}, ShownPointee{address, type, Label(text, n)});
+  }
+
+  void shown_pointee_link(const Label name, const ShownPointee& shown)
+  {
+    details::Text(name);
+    ImGui::SameLine();
+
+    const auto color = ImSweet::StyleColor(ImGuiCol_Text, ImVec4(0.4f, 0.7f, 1.0f, 1.0f));
+    const auto text  = details::frame_format("(already shown at {})", shown.path.view());
+    if (ImGui::Selectable(text.c_str(), false, 0, ImGui::CalcTextSize(text.c_str()))) {
+      auto& state        = ImInspect::get_inspection_state();
+      state.scroll_to    = {shown.address, shown.type};
+      state.scroll_frame = state.frame;
+    }
+    if (ImGui::IsItemHovered())
+      ImGui::SetTooltip("Scroll to where it is expanded");
+  }
+
+  Label frame_string(const std::string_view s)
+  {
+    auto* const p = static_cast<char*>(details::frame_memory().allocate(s.size() + 1, alignof(char)));
+    std::memcpy(p, s.data(), s.size());
+    p[s.size()] = '\0';
+    return Label(p, s.size());
+  }
+
+  NodeState* find_node_state(const ImGuiID id, const void* const type)
+  {
+    auto&      store = ImInspect::get_node_states();
+    const auto it    = store.entries.find(id);
+    if (it == store.entries.end() || it->second.type != type)
+      return nullptr;
+    it->second.last_used_frame = store.frame;
+    return it->second.state.get();
+  }
+
+  NodeState& emplace_node_state(const ImGuiID id, const void* const type, std::unique_ptr<NodeState> state)
+  {
+    auto& store = ImInspect::get_node_states();
+    auto& entry = store.entries[id];
+    entry       = {type, store.frame, static_cast<std::unique_ptr<NodeState>&&>(state)};
+    return *entry.state;
+  }
+
+  bool begin_clipped_region(const std::size_t count)
+  {
+    const auto max_rows = static_cast<std::size_t>(std::max(ImInspect::GetConfig().ClipVisibleRows, 1));
+    const auto rows     = static_cast<float>(std::min(count, max_rows));
+    const auto height   = rows * ImGui::GetFrameHeightWithSpacing() + ImGui::GetStyle().WindowPadding.y * 2;
+    return ImGui::BeginChild("ClippedRows", ImVec2(0, height), true);
+  }
+
+  void end_clipped_region() { ImGui::EndChild(); }
+
+  float RowHeights::offset(const std::size_t i, const float row) const
+  {
+    float y = static_cast<float>(i) * row;
+    for (auto it = uneven.begin(); it != uneven.end() && it->first < i; ++it)
+      y += it->second - row;
+    return y;
+  }
+
+  std::pair<std::size_t, float> RowHeights::row_at(const float y, const std::size_t count, const float row) const
+  {
+    // `at` is the offset of row `index`, rows between two uneven ones are one `row` high
+    std::size_t index = 0;
+    float       at    = 0;
+    for (const auto& [i, height] : uneven) {
+      const float start = at + static_cast<float>(i - index) * row;
+      if (y < start)
+        break;
+      index = i;
+      at    = start;
+      if (y < start + height)
+        return {index, at};
+      index = i + 1;
+      at    = start + height;
+    }
+
+    if (index >= count)
+      return {count - 1, offset(count - 1, row)};
+    const auto skipped = y > at ? static_cast<std::size_t>((y - at) / row) : 0;
+    const auto i       = std::min(index + skipped, count - 1);
+    return {i, at + static_cast<float>(i - index) * row};
+  }
+
+  void RowHeights::measured(const std::size_t i, const float height, const float row)
+  {
+    if (usual <= 0)
+      usual = height;
+    if (std::abs(height - row) < 0.5f)
+      uneven.erase(i);
+    else
+      uneven.insert_or_assign(i, height);
+  }
+
+
+  bool inspect_filesystem_path(void* const fs, const Label name)
   {
     assert(fs != nullptr);
-    auto&       path = *static_cast<std::filesystem::path*>(fs);
-    std::string s    = path.string();
+    auto& path = *static_cast<std::filesystem::path*>(fs);
+    auto  s    = path.string<char, std::char_traits<char>>(std::pmr::polymorphic_allocator<char>(&frame_memory()));
 
-    const ImSweet::ID id(name);
-    ImGui::InputText("", &s);
+    const ImSweet::ID id(name.c_str());
+    const bool        changed = ImInspect::input_text("", s);
     ImGui::SameLine();
-    ImInspect::display_label_with_type_tooltip(name, type_name<decltype(path)>);
-    path = static_cast<std::string&&>(s);
+    ImInspect::display_label_with_type_tooltip(name, normalized_type_name<decltype(path)>);
+    // assigning allocates, only do it when the text was edited
+    if (changed)
+      path = std::string_view(s);
+    return changed;
   }
 
   bool red_button(const char* const name)
@@ -567,19 +2307,28 @@ namespace details {
     details::Text(prefix);
     float label_width = ImGui::CalcTextSize(prefix).x;
 
+    // tooltips grow with their content, wrap before they take more than the configured part of the display
+    const auto& config = ImInspect::GetConfig();
+    const float width  = config.TypeTooltipWidth > 0 ? config.TypeTooltipWidth : ImGui::GetIO().DisplaySize.x * 0.5f;
+    const float glyph  = ImGui::CalcTextSize("abcdefghijklmnopqrstuvwxyz").x / 26;
+    const auto  columns = static_cast<std::size_t>(std::max(width - label_width, glyph * 40) / glyph);
+
     ImGui::SameLine();
-    auto pretty = ImInspect::pretty_typename(ImInspect::normalize_type_name(name));
-    ImInspect::colored_pretty_typename(pretty, label_width);
+    ImInspect::colored_pretty_typename(ImInspect::pretty_typename(details::with_user_aliases(name), columns), label_width);
   }
 
-  void display_readonly_data(const std::string_view s, const std::string& name, const std::string_view type_name)
+  void display_readonly_data(const std::string_view s, const Label name, const std::string_view type_name)
   {
+    if (s.size() > ImInspect::GetConfig().LargeStringThreshold) {
+      ImInspect::large_string(s, nullptr, name, type_name);
+      return;
+    }
 
-    const ImSweet::ID id(name);
+    const ImSweet::ID id(name.c_str());
     {
       const ImSweet::StyleColor color{{ImGuiCol_FrameBg, ImVec4(0.25f, 0.25f, 0.28f, 1.0f)},
                                       {ImGuiCol_Text, ImVec4(0.9f, 0.9f, 0.9f, 1.0f)}};
-      ImGui::InputText("", const_cast<char*>(s.data()), s.size() + 1, ImGuiInputTextFlags_ReadOnly);
+      ImGui::InputText("", ImInspect::readonly_copy(s), s.size() + 1, ImGuiInputTextFlags_ReadOnly);
     }
     if (ImGui::IsItemHovered()) {
       details::red_tooltip("Cannot edit this field it is not writable.");
@@ -591,16 +2340,13 @@ namespace details {
   }
 
 
-  void display_readonly_data(const std::string_view s, const std::string& name)
+  void display_readonly_data(const std::string_view s, const Label name)
   {
     {
       const auto color = ImSweet::StyleColor(
         {{ImGuiCol_FrameBg, ImVec4(0.25f, 0.25f, 0.28f, 1.0f)}, {ImGuiCol_Text, ImVec4(0.9f, 0.9f, 0.9f, 1.0f)}});
-      // imgui expects size() + 1 or something like.
-      // The const_cast is hacky but I am using input text with readonly
-      // because the text box is nice looking
-      // and I coud not replicate it myself.
-      ImGui::InputText(name.c_str(), const_cast<char*>(s.data()), s.size() + 1, ImGuiInputTextFlags_ReadOnly);
+      // a read only InputText because the text box is nice looking, it gets a copy since it wants a char*
+      ImGui::InputText(name.c_str(), ImInspect::readonly_copy(s), s.size() + 1, ImGuiInputTextFlags_ReadOnly);
     }
     if (ImGui::IsItemHovered())
       details::red_tooltip("Cannot edit this field it is not writable.");
@@ -619,12 +2365,42 @@ namespace details {
 
 } // namespace details
 
+void add_type_alias(const std::string_view pattern, const std::string_view replacement)
+{
+  const auto p = details::normalize_type_name_structurally(pattern);
+  const auto r = details::normalize_type_name_structurally(replacement);
+
+  details::TypeNameRule rule;
+  rule.text                   = std::make_unique<std::string>(p + r);
+  const std::string_view text = *rule.text;
+  rule.pattern.parse(details::tokenize_type_name(text.substr(0, p.size())), {});
+  rule.replacement.parse(details::tokenize_type_name(text.substr(p.size())), {});
+
+  const auto& items = rule.pattern.sequences[0].items;
+  if (items.empty() || items.back().kind != details::TypeNameItem::Template) {
+    assert(!"The pattern of a type alias has to end with a template argument list");
+    return;
+  }
+
+  {
+    const std::unique_lock lock(get_alias_mutex());
+    get_type_aliases().push_back(static_cast<details::TypeNameRule&&>(rule));
+    has_user_aliases = true;
+  }
+  get_normalized_names().clear();
+}
+
 void add_regex_alias(std::string_view regex, std::string_view replacement)
 {
-  auto& set = get_regex_pattern_set();
-  // insert returns {it, true} if new
-  if (set.emplace(regex).second) {
+  {
+    const std::unique_lock lock(get_alias_mutex());
+    auto&                  set = get_regex_pattern_set();
+    // insert returns {it, true} if new
+    if (!set.emplace(regex).second)
+      return;
     get_regex_aliases().push_back({std::regex(regex.data(), regex.data() + regex.size()), std::string(replacement)});
+    has_user_aliases = true;
   }
+  get_normalized_names().clear();
 }
-} // namespace ImInspect
\ No newline at end of file
+} // namespace ImInspect